@@ -45,11 +45,60 @@ fi
 # Step 2: Copy platform files
 echo ""
 echo -e "${YELLOW}Step 2: Copying platform files...${NC}"
+python3 "$SCRIPT_DIR/gen_records.py"  # doom_records.h + plugin frame_records.py
 cp -v "$SCRIPT_DIR/doomgeneric_kicad_dual.c" "$DOOMGENERIC_DIR/doomgeneric/"
 cp -v "$SCRIPT_DIR/doomgeneric_kicad_dual_v2.c" "$DOOMGENERIC_DIR/doomgeneric/"
 cp -v "$SCRIPT_DIR/doomgeneric_sdl_dual.c" "$DOOMGENERIC_DIR/doomgeneric/"
 cp -v "$SCRIPT_DIR/doom_socket.c" "$DOOMGENERIC_DIR/doomgeneric/"
 cp -v "$SCRIPT_DIR/doom_socket.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_assets.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_assets.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_cache.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_cache.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_clock.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_clock.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_motion.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_motion.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_depth.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_depth.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_dynres.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_dynres.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_session.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_session.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_frame.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_export.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_export.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_golden.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_golden.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_idle.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_idle.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_input.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_input.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_json.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_json.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_pacing.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_pacing.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_prefetch.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_prefetch.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_sched.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_sched.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_raster.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_raster.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_records.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_skyline.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_skyline.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_stats.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_stats.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_telemetry.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_telemetry.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_texedges.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_texedges.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_top.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_trace.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_views.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_views.h" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_visplanes.c" "$DOOMGENERIC_DIR/doomgeneric/"
+cp -v "$SCRIPT_DIR/doom_visplanes.h" "$DOOMGENERIC_DIR/doomgeneric/"
 cp -v "$SCRIPT_DIR/Makefile.kicad" "$DOOMGENERIC_DIR/doomgeneric/"
 cp -v "$SCRIPT_DIR/Makefile.kicad_dual" "$DOOMGENERIC_DIR/doomgeneric/"
 echo -e "${GREEN}✓ Platform files copied${NC}"
@@ -74,6 +123,8 @@ echo -e "${YELLOW}Step 4: Installing binary...${NC}"
 mkdir -p "$PLUGIN_DOOM_DIR"
 cp -v doomgeneric_kicad_dual "$PLUGIN_DOOM_DIR/doomgeneric_kicad"
 chmod +x "$PLUGIN_DOOM_DIR/doomgeneric_kicad"
+cp -v doom_top "$PLUGIN_DOOM_DIR/doom_top"
+cp -rv "$SCRIPT_DIR/bpftrace" "$PLUGIN_DOOM_DIR/"
 echo -e "${GREEN}✓ Dual-mode binary installed as $PLUGIN_DOOM_DIR/doomgeneric_kicad${NC}"
 echo -e "${GREEN}  (Shows SDL window + sends vectors)${NC}"
 
@@ -0,0 +1,56 @@
+/**
+ * doom_assets.c
+ *
+ * Vector-only asset profile: no level precache, no pixel loads or draws.
+ */
+
+#include "doom_assets.h"
+
+#include <stdio.h>
+#include <sys/resource.h>
+
+#include "doomstat.h"
+#include "i_system.h"
+
+#ifdef KIDOOM_LAZY_ASSETS
+/* Defined by patches/lazy_assets.patch (r_main.c) */
+extern boolean kidoom_vector_only;
+#endif
+
+static int g_vector_only = 0;
+
+/**
+ * Helper: Print the peak resident set size on exit.
+ */
+static void assets_report(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) < 0) {
+        return;
+    }
+#ifdef __APPLE__
+    long peak_kb = usage.ru_maxrss / 1024;  /* Bytes on macOS */
+#else
+    long peak_kb = usage.ru_maxrss;
+#endif
+    printf("Assets: %s profile, peak RSS %.1f MB\n",
+           g_vector_only ? "vector-only" : "full", peak_kb / 1024.0);
+}
+
+void doom_assets_init(int vector_only) {
+    I_AtExit(assets_report, true);
+    if (!vector_only) {
+        return;
+    }
+
+    /* Nothing draws the level's graphics, don't load them all up front */
+    g_vector_only = 1;
+    precache = false;
+
+#ifdef KIDOOM_LAZY_ASSETS
+    kidoom_vector_only = true;
+    printf("✓ Vector-only assets: no precache, textures/flats/sprites never loaded\n");
+#else
+    printf("✓ Vector-only assets: no precache (patches/lazy_assets.patch and "
+           "-DKIDOOM_LAZY_ASSETS also skip pixel draws)\n");
+#endif
+}
@@ -0,0 +1,30 @@
+/**
+ * doom_assets.h
+ *
+ * Vector-only asset profile.
+ *
+ * Wall textures, flats and sprite patches only matter to sinks that look at
+ * pixels: the SDL window and its screenshots. Headless runs (KiCad and
+ * scope deployments without the SDL sink) still had DOOM precache every
+ * graphic a level uses at level setup and composite/draw them every frame.
+ * In vector-only mode level precaching is turned off, and with
+ * patches/lazy_assets.patch the renderer walks, clips and builds visplanes
+ * and vissprites as usual (everything extraction reads) but never loads or
+ * draws texture, flat or sprite pixels. DOOM's zone cache loads lumps on
+ * first use, so a sink that draws again simply loads what it needs then.
+ */
+
+#ifndef DOOM_ASSETS_H
+#define DOOM_ASSETS_H
+
+/**
+ * Select the asset profile. Registers an exit handler that prints the peak
+ * resident set size, for comparing profiles.
+ *
+ * Args:
+ *   vector_only: 1 when no sink needs pixels (headless), 0 for the normal
+ *                profile
+ */
+void doom_assets_init(int vector_only);
+
+#endif /* DOOM_ASSETS_H */
@@ -0,0 +1,382 @@
+/**
+ * doom_cache.c
+ *
+ * Startup cache file: texture column lookups and sprite metrics.
+ *
+ * Layout (native endianness, every part 4-byte aligned):
+ *   cache_header_t
+ *   per texture: int32 width, int32 compositesize, int16 lump[width],
+ *                uint16 ofs[width], padding
+ *   int32 sprite width[n], offset[n], topoffset[n]
+ */
+
+#include "doom_cache.h"
+#include "doom_clock.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "doomtype.h"
+#include "m_argv.h"
+#include "m_fixed.h"
+#include "w_checksum.h"
+
+#ifdef KIDOOM_STARTUP_CACHE
+
+#define CACHE_PATH_MAX 512
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint8_t key[20];           /* W_Checksum() of the loaded WADs */
+    uint32_t texture_count;
+    uint32_t sprite_count;
+    uint32_t texture_bytes;    /* Size of the texture records */
+    uint32_t reserved;
+} cache_header_t;
+
+/* Hooks defined by patches/startup_cache.patch (r_data.c) */
+extern boolean (*kidoom_cache_load_texture) (int texnum, int width, short* columnlump,
+                                             unsigned short* columnofs, int* compositesize);
+extern void (*kidoom_cache_store_texture) (int texnum, int width, const short* columnlump,
+                                           const unsigned short* columnofs, int compositesize);
+extern boolean (*kidoom_cache_load_sprites) (int count, fixed_t* width, fixed_t* offset,
+                                             fixed_t* topoffset);
+extern void (*kidoom_cache_store_sprites) (int count, const fixed_t* width,
+                                           const fixed_t* offset, const fixed_t* topoffset);
+
+static int g_opened = 0;
+static int g_disabled = 0;
+static char g_path[CACHE_PATH_MAX + 64];
+static uint8_t g_key[20];
+
+/* Mapped cache file */
+static const uint8_t* g_map = NULL;
+static size_t g_map_size = 0;
+static const cache_header_t* g_header = NULL;
+static const uint8_t** g_texture_records = NULL;
+
+/* What this launch generated or loaded, for rewriting the file */
+static uint8_t* g_textures = NULL;
+static size_t g_textures_len = 0;
+static size_t g_textures_cap = 0;
+static int g_texture_count = 0;
+static int32_t* g_sprites = NULL;
+static int g_sprite_count = 0;
+
+static int g_texture_hits = 0;
+static int g_texture_misses = 0;
+static int g_sprite_hit = 0;
+static uint64_t g_first_us = 0;
+static uint64_t g_last_us = 0;
+
+/**
+ * Helper: Size of one texture record.
+ */
+static size_t record_size(int width) {
+    return (8 + (size_t)width * 4 + 3) & ~(size_t)3;
+}
+
+/**
+ * Helper: Create a directory and any missing parents (mkdir -p).
+ */
+static void make_dirs(const char* dir) {
+    char path[CACHE_PATH_MAX];
+    snprintf(path, sizeof(path), "%s", dir);
+    for (char* p = path + 1; *p != '\0'; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(path, 0755);
+            *p = '/';
+        }
+    }
+    mkdir(path, 0755);
+}
+
+/**
+ * Helper: Map the cache file and check it belongs to the loaded WADs.
+ */
+static void map_cache(void) {
+    int fd = open(g_path, O_RDONLY);
+    if (fd < 0) {
+        return;  /* First launch with these WADs */
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(cache_header_t)) {
+        close(fd);
+        return;
+    }
+
+    void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("doom_cache: mmap");
+        return;
+    }
+
+    const cache_header_t* header = (const cache_header_t*)map;
+    size_t expected = sizeof(cache_header_t) + header->texture_bytes +
+                      (size_t)header->sprite_count * 3 * sizeof(int32_t);
+    if (header->magic != CACHE_MAGIC || header->version != CACHE_VERSION ||
+        memcmp(header->key, g_key, sizeof(g_key)) != 0 || expected != (size_t)st.st_size) {
+        fprintf(stderr, "Warning: startup cache %s is stale, rebuilding\n", g_path);
+        munmap(map, st.st_size);
+        return;
+    }
+
+    /* Index the texture records (bounds-checked) */
+    const uint8_t* base = (const uint8_t*)map + sizeof(cache_header_t);
+    const uint8_t** index = malloc(header->texture_count * sizeof(*index) + 1);
+    size_t pos = 0;
+    for (uint32_t i = 0; index != NULL && i < header->texture_count; i++) {
+        int32_t width;
+        if (pos + 8 > header->texture_bytes) {
+            free(index);
+            index = NULL;
+            break;
+        }
+        memcpy(&width, base + pos, sizeof(width));
+        if (width <= 0 || pos + record_size(width) > header->texture_bytes) {
+            free(index);
+            index = NULL;
+            break;
+        }
+        index[i] = base + pos;
+        pos += record_size(width);
+    }
+    if (index == NULL) {
+        fprintf(stderr, "Warning: startup cache %s is damaged, rebuilding\n", g_path);
+        munmap(map, st.st_size);
+        return;
+    }
+
+    g_map = (const uint8_t*)map;
+    g_map_size = st.st_size;
+    g_header = header;
+    g_texture_records = index;
+}
+
+/**
+ * Helper: Resolve options and the cache file on the first hook call
+ * (the WADs are loaded by then).
+ */
+static void open_cache(void) {
+    g_opened = 1;
+    g_first_us = doom_clock_us();
+
+    if (M_CheckParm("-nocache")) {
+        g_disabled = 1;
+        return;
+    }
+
+    char dir[CACHE_PATH_MAX];
+    int dir_arg = M_CheckParmWithArgs("-cachedir", 1);
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (dir_arg) {
+        snprintf(dir, sizeof(dir), "%s", myargv[dir_arg + 1]);
+    } else if (xdg != NULL && xdg[0] != '\0') {
+        snprintf(dir, sizeof(dir), "%s/kidoom", xdg);
+    } else if (home != NULL) {
+        snprintf(dir, sizeof(dir), "%s/.cache/kidoom", home);
+    } else {
+        g_disabled = 1;
+        return;
+    }
+    make_dirs(dir);
+
+    W_Checksum(g_key);
+    char hex[41];
+    for (int i = 0; i < 20; i++) {
+        snprintf(hex + i * 2, 3, "%02x", g_key[i]);
+    }
+    snprintf(g_path, sizeof(g_path), "%s/startup-%s.cache", dir, hex);
+
+    map_cache();
+}
+
+static boolean cache_load_texture(int texnum, int width, short* columnlump,
+                                  unsigned short* columnofs, int* compositesize) {
+    if (!g_opened) {
+        open_cache();
+    }
+    if (g_header == NULL || texnum < 0 || (uint32_t)texnum >= g_header->texture_count) {
+        g_texture_misses++;
+        return false;
+    }
+
+    const uint8_t* record = g_texture_records[texnum];
+    int32_t cached_width, cached_size;
+    memcpy(&cached_width, record, sizeof(cached_width));
+    memcpy(&cached_size, record + 4, sizeof(cached_size));
+    if (cached_width != width) {
+        g_texture_misses++;
+        return false;
+    }
+
+    memcpy(columnlump, record + 8, width * sizeof(short));
+    memcpy(columnofs, record + 8 + width * sizeof(short), width * sizeof(unsigned short));
+    *compositesize = cached_size;
+    g_texture_hits++;
+    return true;
+}
+
+static void cache_store_texture(int texnum, int width, const short* columnlump,
+                                const unsigned short* columnofs, int compositesize) {
+    if (g_disabled || texnum != g_texture_count) {
+        return;  /* Only consecutive textures make a valid section */
+    }
+
+    size_t size = record_size(width);
+    if (g_textures_len + size > g_textures_cap) {
+        size_t cap = g_textures_cap ? g_textures_cap * 2 : 65536;
+        while (cap < g_textures_len + size) cap *= 2;
+        uint8_t* grown = realloc(g_textures, cap);
+        if (grown == NULL) {
+            g_disabled = 1;
+            return;
+        }
+        g_textures = grown;
+        g_textures_cap = cap;
+    }
+
+    uint8_t* record = g_textures + g_textures_len;
+    int32_t w = width, s = compositesize;
+    memset(record, 0, size);
+    memcpy(record, &w, sizeof(w));
+    memcpy(record + 4, &s, sizeof(s));
+    memcpy(record + 8, columnlump, width * sizeof(short));
+    memcpy(record + 8 + width * sizeof(short), columnofs, width * sizeof(unsigned short));
+
+    g_textures_len += size;
+    g_texture_count++;
+    g_last_us = doom_clock_us();
+}
+
+static boolean cache_load_sprites(int count, fixed_t* width, fixed_t* offset, fixed_t* topoffset) {
+    if (!g_opened) {
+        open_cache();
+    }
+    if (g_header == NULL || g_header->sprite_count != (uint32_t)count) {
+        return false;
+    }
+
+    const uint8_t* sprites = g_map + sizeof(cache_header_t) + g_header->texture_bytes;
+    memcpy(width, sprites, count * sizeof(int32_t));
+    memcpy(offset, sprites + count * sizeof(int32_t), count * sizeof(int32_t));
+    memcpy(topoffset, sprites + 2 * count * sizeof(int32_t), count * sizeof(int32_t));
+    g_sprite_hit = 1;
+    return true;
+}
+
+static void cache_store_sprites(int count, const fixed_t* width,
+                                const fixed_t* offset, const fixed_t* topoffset) {
+    if (g_disabled) {
+        return;
+    }
+
+    g_sprites = malloc(count * 3 * sizeof(int32_t));
+    if (g_sprites == NULL) {
+        g_disabled = 1;
+        return;
+    }
+    memcpy(g_sprites, width, count * sizeof(int32_t));
+    memcpy(g_sprites + count, offset, count * sizeof(int32_t));
+    memcpy(g_sprites + 2 * count, topoffset, count * sizeof(int32_t));
+    g_sprite_count = count;
+    g_last_us = doom_clock_us();
+}
+
+/**
+ * Helper: Write the collected data (temporary file + rename, so a reader
+ * never sees a partial cache).
+ *
+ * Returns: 0 on success, -1 on error
+ */
+static int write_cache(void) {
+    char tmp_path[sizeof(g_path) + 16];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%d", g_path, (int)getpid());
+
+    FILE* f = fopen(tmp_path, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Warning: can't write startup cache %s: %s\n", tmp_path, strerror(errno));
+        return -1;
+    }
+
+    cache_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    memcpy(header.key, g_key, sizeof(g_key));
+    header.texture_count = g_texture_count;
+    header.sprite_count = g_sprite_count;
+    header.texture_bytes = (uint32_t)g_textures_len;
+
+    int ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+             (g_textures_len == 0 || fwrite(g_textures, g_textures_len, 1, f) == 1) &&
+             fwrite(g_sprites, sizeof(int32_t), g_sprite_count * 3, f) == (size_t)g_sprite_count * 3;
+    if (fclose(f) != 0 || !ok || rename(tmp_path, g_path) != 0) {
+        fprintf(stderr, "Warning: failed to write startup cache %s\n", g_path);
+        unlink(tmp_path);
+        return -1;
+    }
+    return 0;
+}
+
+void doom_cache_install(void) {
+    kidoom_cache_load_texture = cache_load_texture;
+    kidoom_cache_store_texture = cache_store_texture;
+    kidoom_cache_load_sprites = cache_load_sprites;
+    kidoom_cache_store_sprites = cache_store_sprites;
+}
+
+void doom_cache_finish(void) {
+    if (!g_opened || g_disabled) {
+        return;
+    }
+
+    double ms = (g_last_us > g_first_us ? g_last_us - g_first_us : 0) / 1000.0;
+    if (g_header != NULL && g_texture_misses == 0 && g_sprite_hit) {
+        printf("✓ Startup cache hit: %d textures, %d sprites in %.1f ms\n",
+               g_texture_hits, g_sprite_count, ms);
+    } else if (g_sprite_count > 0 && write_cache() == 0) {
+        printf("✓ Startup cache written: %d textures, %d sprites generated in %.1f ms (%s)\n",
+               g_texture_count, g_sprite_count, ms, g_path);
+    }
+
+    /* The tables live in the zone now */
+    if (g_map != NULL) {
+        munmap((void*)g_map, g_map_size);
+        g_map = NULL;
+        g_header = NULL;
+    }
+    free(g_texture_records);
+    free(g_textures);
+    free(g_sprites);
+    g_texture_records = NULL;
+    g_textures = NULL;
+    g_sprites = NULL;
+    g_disabled = 1;
+}
+
+#else
+
+void doom_cache_install(void) {
+}
+
+void doom_cache_finish(void) {
+    if (M_CheckParm("-cachedir")) {
+        fprintf(stderr, "Warning: -cachedir requires patches/startup_cache.patch "
+                        "and -DKIDOOM_STARTUP_CACHE\n");
+    }
+}
+
+#endif /* KIDOOM_STARTUP_CACHE */
@@ -0,0 +1,39 @@
+/**
+ * doom_cache.h
+ *
+ * Persistent startup cache for derived renderer data.
+ *
+ * R_InitData() builds the texture column lookups (which patch and offset
+ * each texture column comes from, and the composite sizes) by reading every
+ * patch of every texture, and reads every sprite lump for its size and
+ * offsets. None of it changes while the WAD set doesn't. With
+ * patches/startup_cache.patch applied, the results are written to a cache
+ * file named after the SHA-1 of the loaded WADs' lump directories
+ * (W_Checksum()) and mmapped back on later launches, skipping the patch
+ * reads. A cache that doesn't match the loaded data is ignored and
+ * rewritten.
+ *
+ * Options: -cachedir <dir> (default $XDG_CACHE_HOME/kidoom or
+ * ~/.cache/kidoom), -nocache.
+ */
+
+#ifndef DOOM_CACHE_H
+#define DOOM_CACHE_H
+
+#define CACHE_MAGIC   0x4b444348u  /* "KDCH" */
+#define CACHE_VERSION 1
+
+/**
+ * Install the r_data.c hooks. Must run before doomgeneric_Create() (the
+ * renderer is initialised before DG_Init()); options are read on first use.
+ * No-op unless built with -DKIDOOM_STARTUP_CACHE.
+ */
+void doom_cache_install(void);
+
+/**
+ * Write the cache if it was missing or stale and print what happened.
+ * Call once the renderer is initialised (DG_Init()).
+ */
+void doom_cache_finish(void);
+
+#endif /* DOOM_CACHE_H */
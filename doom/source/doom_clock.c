@@ -0,0 +1,22 @@
+/**
+ * doom_clock.c
+ *
+ * Monotonic clock implementation.
+ */
+
+#include "doom_clock.h"
+
+#include <time.h>
+
+uint64_t doom_clock_us(void) {
+    struct timespec ts;
+
+#ifdef __APPLE__
+    /* Doesn't advance while the machine sleeps, and skips the NTP slewing */
+    clock_gettime(CLOCK_UPTIME_RAW, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)(ts.tv_nsec / 1000);
+}
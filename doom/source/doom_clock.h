@@ -0,0 +1,24 @@
+/**
+ * doom_clock.h
+ *
+ * Monotonic timestamps for frame metadata and timing measurements.
+ *
+ * gettimeofday() follows wall-clock adjustments (NTP, manual changes), so it
+ * can jump backwards. Anything consumers compare across frames uses this
+ * clock instead.
+ */
+
+#ifndef DOOM_CLOCK_H
+#define DOOM_CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * Get monotonic time in microseconds.
+ * The epoch is arbitrary (typically system boot); only differences matter.
+ *
+ * Returns: Microseconds since an unspecified fixed point
+ */
+uint64_t doom_clock_us(void);
+
+#endif /* DOOM_CLOCK_H */
@@ -0,0 +1,43 @@
+/**
+ * doom_depth.c
+ *
+ * Counting sort over quantised distances.
+ */
+
+#include "doom_depth.h"
+
+#include <string.h>
+
+static int g_bucket_start[DEPTH_MAX + 2];
+
+/**
+ * Helper: Clamp a key into the histogram range.
+ */
+static int clamp_key(int key) {
+    if (key < 0) return 0;
+    if (key > DEPTH_MAX) return DEPTH_MAX;
+    return key;
+}
+
+void doom_depth_sort(const short* keys, int count, int direction, short* order) {
+    memset(g_bucket_start, 0, sizeof(g_bucket_start));
+
+    /* Histogram, indexed in draw order (bucket 0 is drawn first) */
+    for (int i = 0; i < count; i++) {
+        int k = clamp_key(keys[i]);
+        int bucket = (direction == DEPTH_FAR_TO_NEAR) ? DEPTH_MAX - k : k;
+        g_bucket_start[bucket + 1]++;
+    }
+
+    /* Prefix sum: first output slot of each bucket */
+    for (int b = 0; b <= DEPTH_MAX; b++) {
+        g_bucket_start[b + 1] += g_bucket_start[b];
+    }
+
+    /* Scatter in input order, which keeps the sort stable */
+    for (int i = 0; i < count; i++) {
+        int k = clamp_key(keys[i]);
+        int bucket = (direction == DEPTH_FAR_TO_NEAR) ? DEPTH_MAX - k : k;
+        order[g_bucket_start[bucket]++] = (short)i;
+    }
+}
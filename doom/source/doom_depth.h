@@ -0,0 +1,34 @@
+/**
+ * doom_depth.h
+ *
+ * Depth ordering of frame primitives.
+ *
+ * Walls and sprites are sent with a distance already quantised to 0-999, so a
+ * counting sort orders any number of primitives in linear time with a fixed
+ * 1000-bucket histogram. Consumers then draw in emission order instead of
+ * sorting every frame themselves.
+ */
+
+#ifndef DOOM_DEPTH_H
+#define DOOM_DEPTH_H
+
+/* Quantised distance range: 0 = nearest, DEPTH_MAX = farthest */
+#define DEPTH_MAX 999
+
+/* Sort direction */
+#define DEPTH_FAR_TO_NEAR 0  /* Painter's order (back to front) */
+#define DEPTH_NEAR_TO_FAR 1  /* Front to back (for occlusion culling) */
+
+/**
+ * Order primitives by quantised distance (stable counting sort).
+ * Primitives with equal distance keep their input order.
+ *
+ * Args:
+ *   keys: Distance of each primitive (0..DEPTH_MAX, out of range is clamped)
+ *   count: Number of primitives
+ *   direction: DEPTH_FAR_TO_NEAR or DEPTH_NEAR_TO_FAR
+ *   order: Output - primitive indices in draw order (count entries)
+ */
+void doom_depth_sort(const short* keys, int count, int direction, short* order);
+
+#endif /* DOOM_DEPTH_H */
@@ -0,0 +1,188 @@
+/**
+ * doom_dynres.c
+ *
+ * Frame-time budget controller over DOOM's view size and detail level.
+ */
+
+#include "doom_dynres.h"
+
+#include <stdio.h>
+
+#include "doomdef.h"
+#include "m_fixed.h"
+#include "r_main.h"
+
+#define DYNRES_MAX_LEVELS 12
+
+/* Average over roughly the last 8 frames */
+#define DYNRES_AVERAGE_SHIFT 3
+
+typedef struct {
+    int blocks;  /* R_SetViewSize() screen size (3..11) */
+    int detail;  /* 0 = high, 1 = low */
+} dynres_level_t;
+
+/* Declare external DOOM variables (defined in m_menu.c / r_state) */
+extern int screenblocks;
+extern int detailLevel;
+extern int viewwidth;
+extern int viewheight;
+
+static int g_enabled = 0;
+static uint64_t g_budget_us = 0;
+
+static dynres_level_t g_levels[DYNRES_MAX_LEVELS];
+static int g_level_count = 0;
+static int g_level = 0;
+
+/* User's setting the ladder was built from */
+static int g_ref_blocks = -1;
+static int g_ref_detail = -1;
+static int g_ref_width = SCREENWIDTH;
+static int g_ref_height = SCREENHEIGHT;
+
+static int64_t g_average_us = 0;
+static int g_settle = 0;
+static int g_fast_frames = 0;
+
+/* View -> output scale for the current frame (16.16) */
+static fixed_t g_scale_x = FRACUNIT;
+static fixed_t g_scale_y = FRACUNIT;
+
+/**
+ * Helper: View size R_ExecuteSetViewSize() produces for a setting.
+ */
+static void view_size(int blocks, int detail, int* width, int* height) {
+    if (blocks >= 11) {
+        *width = SCREENWIDTH;
+        *height = SCREENHEIGHT;
+    } else {
+        *width = blocks * 32;
+        *height = (blocks * 168 / 10) & ~7;
+    }
+    *width >>= detail;
+}
+
+/**
+ * Helper: Build the quality ladder from the user's current setting -
+ * low detail first, then one view size step at a time.
+ */
+static void build_levels(void) {
+    g_ref_blocks = screenblocks;
+    g_ref_detail = detailLevel;
+    view_size(g_ref_blocks, g_ref_detail, &g_ref_width, &g_ref_height);
+
+    g_level_count = 0;
+    g_levels[g_level_count].blocks = g_ref_blocks;
+    g_levels[g_level_count].detail = g_ref_detail;
+    g_level_count++;
+
+    if (g_ref_detail == 0) {
+        g_levels[g_level_count].blocks = g_ref_blocks;
+        g_levels[g_level_count].detail = 1;
+        g_level_count++;
+    }
+
+    for (int b = g_ref_blocks - 1; b >= DYNRES_MIN_BLOCKS && g_level_count < DYNRES_MAX_LEVELS; b--) {
+        g_levels[g_level_count].blocks = b;
+        g_levels[g_level_count].detail = 1;
+        g_level_count++;
+    }
+
+    g_level = 0;
+    g_settle = DYNRES_SETTLE_FRAMES;
+    g_fast_frames = 0;
+}
+
+/**
+ * Helper: Switch to a ladder level (applied on DOOM's next display).
+ */
+static void set_level(int level) {
+    g_level = level;
+    g_settle = DYNRES_SETTLE_FRAMES;
+    g_fast_frames = 0;
+    R_SetViewSize(g_levels[level].blocks, g_levels[level].detail);
+}
+
+void doom_dynres_start(uint64_t budget_us) {
+    g_enabled = 1;
+    g_budget_us = budget_us;
+    g_average_us = 0;
+    build_levels();
+
+    printf("✓ Dynamic resolution: %.1f ms budget, %d levels\n",
+           budget_us / 1000.0, g_level_count);
+}
+
+void doom_dynres_frame(uint64_t work_us) {
+    if (!g_enabled) {
+        return;
+    }
+
+    /* The user changed size/detail in the menu: that is the new reference */
+    if (screenblocks != g_ref_blocks || detailLevel != g_ref_detail) {
+        build_levels();
+    }
+
+    g_average_us += ((int64_t)work_us - g_average_us) >> DYNRES_AVERAGE_SHIFT;
+
+    if (g_settle > 0) {
+        g_settle--;
+        return;
+    }
+
+    if (g_average_us > (int64_t)g_budget_us) {
+        if (g_level + 1 < g_level_count) {
+            set_level(g_level + 1);
+        }
+        return;
+    }
+
+    if (g_level > 0 && g_average_us < (int64_t)(g_budget_us * DYNRES_UP_PERCENT / 100)) {
+        if (++g_fast_frames >= DYNRES_UP_FRAMES) {
+            set_level(g_level - 1);
+        }
+    } else {
+        g_fast_frames = 0;
+    }
+}
+
+void doom_dynres_begin_frame(void) {
+    if (!g_enabled || viewwidth <= 0 || viewheight <= 0) {
+        return;
+    }
+
+    g_scale_x = (fixed_t)(((int64_t)g_ref_width << FRACBITS) / viewwidth);
+    g_scale_y = (fixed_t)(((int64_t)g_ref_height << FRACBITS) / viewheight);
+}
+
+int doom_dynres_x(int x) {
+    return (int)(((int64_t)x * g_scale_x + FRACUNIT / 2) >> FRACBITS);
+}
+
+int doom_dynres_y(int y) {
+    return (int)(((int64_t)y * g_scale_y + FRACUNIT / 2) >> FRACBITS);
+}
+
+void doom_dynres_map_points(short (*points)[2], int count) {
+    if (g_scale_x == FRACUNIT && g_scale_y == FRACUNIT) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        points[i][0] = (short)doom_dynres_x(points[i][0]);
+        points[i][1] = (short)doom_dynres_y(points[i][1]);
+    }
+}
+
+void doom_dynres_report(void) {
+    if (!g_enabled) {
+        return;
+    }
+
+    int width, height;
+    view_size(g_levels[g_level].blocks, g_levels[g_level].detail, &width, &height);
+    printf("Dynamic resolution: level %d/%d (%dx%d, %s detail) | work avg %.1f ms of %.1f ms\n",
+           g_level, g_level_count - 1, width, height,
+           g_levels[g_level].detail ? "low" : "high",
+           g_average_us / 1000.0, g_budget_us / 1000.0);
+}
@@ -0,0 +1,68 @@
+/**
+ * doom_dynres.h
+ *
+ * Dynamic render-resolution scaling.
+ *
+ * Watches how long each frame takes to simulate, render and extract, and
+ * trades resolution for time when a scene gets heavy: first DOOM's low
+ * detail mode (half the columns), then smaller view sizes through
+ * R_SetViewSize(), and back up again once there is headroom. Steps down are
+ * immediate, steps up need a run of fast frames, and every change is
+ * followed by a settling period so the controller doesn't oscillate.
+ *
+ * Emitted vector coordinates are rescaled to the view size the user picked,
+ * so consumers always see the same coordinate space.
+ */
+
+#ifndef DOOM_DYNRES_H
+#define DOOM_DYNRES_H
+
+#include <stdint.h>
+
+#define DYNRES_MIN_BLOCKS    6   /* Smallest view size the controller uses */
+#define DYNRES_UP_PERCENT    70  /* Step up below this share of the budget... */
+#define DYNRES_UP_FRAMES     35  /* ...for this many consecutive frames */
+#define DYNRES_SETTLE_FRAMES 16  /* Frames ignored after every change */
+
+/**
+ * Enable the controller. The current screenblocks / detail setting becomes
+ * the full-quality level and the output coordinate space.
+ *
+ * Args:
+ *   budget_us: Target simulate + render + extract time per frame
+ */
+void doom_dynres_start(uint64_t budget_us);
+
+/**
+ * Feed one frame's measured work time. May request a new view size, which
+ * DOOM applies on its next D_Display().
+ *
+ * Args:
+ *   work_us: Time spent on the frame, excluding sleeps and presentation
+ */
+void doom_dynres_frame(uint64_t work_us);
+
+/**
+ * Update the coordinate mapping for the frame that was just rendered.
+ * Call before extraction (viewwidth/viewheight describe that frame).
+ */
+void doom_dynres_begin_frame(void);
+
+/**
+ * Map a view coordinate of the current frame to the output space.
+ * Identity when the controller is off or at full quality.
+ */
+int doom_dynres_x(int x);
+int doom_dynres_y(int y);
+
+/**
+ * Map (x, y) vertex pairs in place.
+ */
+void doom_dynres_map_points(short (*points)[2], int count);
+
+/**
+ * Print current level and average work time (for the periodic stats line).
+ */
+void doom_dynres_report(void);
+
+#endif /* DOOM_DYNRES_H */
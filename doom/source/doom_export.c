@@ -0,0 +1,314 @@
+/**
+ * doom_export.c
+ *
+ * Worker pool for the export sink. The main thread copies each frame into a
+ * free queue slot; a worker copies it out again under the lock and formats
+ * it without holding the lock, so DOOM only waits when the queue is full.
+ */
+
+#include "doom_export.h"
+#include "doom_clock.h"
+#include "doom_sched.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "i_system.h"
+
+#define EXPORT_QUEUE_SIZE (2 * EXPORT_MAX_THREADS)
+#define EXPORT_PATH_MAX 512
+
+/* Same mapping as CoordinateTransform.doom_to_kicad(): 0.5mm per pixel,
+ * screen centre on the A4 page centre */
+#define KICAD_MM_PER_PIXEL 0.5
+#define KICAD_CENTER_X_MM  148.5
+#define KICAD_CENTER_Y_MM  105.0
+
+/* Same as DISTANCE_THRESHOLD / TRACE_WIDTH_* in the plugin config */
+#define KICAD_DISTANCE_THRESHOLD 100
+#define KICAD_WIDTH_CLOSE_MM     0.3
+#define KICAD_WIDTH_FAR_MM       0.15
+
+typedef struct {
+    pthread_t thread;
+    int index;
+    doom_frame_t frame;  /* Private copy being written */
+} export_worker_t;
+
+static char g_dir[EXPORT_PATH_MAX];
+static int g_formats = 0;
+static int g_thread_count = 0;
+static int g_running = 0;
+
+static doom_frame_t g_queue[EXPORT_QUEUE_SIZE];
+static uint64_t g_queue_time_us[EXPORT_QUEUE_SIZE];  /* When each slot was queued */
+static int g_queue_head = 0;
+static int g_queue_count = 0;
+static int g_stopping = 0;
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_not_full = PTHREAD_COND_INITIALIZER;
+
+static export_worker_t g_workers[EXPORT_MAX_THREADS];
+
+static uint64_t g_start_us = 0;
+static int g_frames_written = 0;  /* Protected by g_lock */
+static int g_frames_failed = 0;   /* Protected by g_lock */
+
+/**
+ * Helper: Depth-cued brightness, same curve as the ScopeDoom renderer.
+ */
+static int distance_brightness(int distance, float falloff) {
+    float t = distance / 500.0f;
+    if (t > 1.0f) t = 1.0f;
+    return (int)(255 * (1.0f - t * falloff));
+}
+
+/**
+ * Helper: Close an output file, reporting any write error.
+ *
+ * Returns: 0 if everything was written, -1 on error
+ */
+static int close_output(FILE* f) {
+    int failed = ferror(f);
+    return (fclose(f) != 0 || failed) ? -1 : 0;
+}
+
+/**
+ * Helper: Write a frame as SVG in DOOM screen coordinates.
+ *
+ * Returns: 0 on success, -1 on error
+ */
+static int write_svg(const doom_frame_t* frame, const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        return -1;
+    }
+
+    fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 %d %d\" "
+               "width=\"%d\" height=\"%d\">\n", SCREENWIDTH, SCREENHEIGHT,
+            SCREENWIDTH * 3, SCREENHEIGHT * 3);
+    fprintf(f, "<rect width=\"100%%\" height=\"100%%\" fill=\"black\"/>\n");
+    fprintf(f, "<g fill=\"none\" stroke-width=\"0.8\">\n");
+
+    for (int i = 0; i < frame->wall_count; i++) {
+        const wall_record_t* w = &frame->walls[i];
+        if (w->silhouette == 0) {
+            continue;  /* Portal - nothing solid to draw */
+        }
+        fprintf(f, "<polygon points=\"%d,%d %d,%d %d,%d %d,%d\" stroke=\"#00%02x00\"/>\n",
+                w->x1, w->y1_top, w->x2, w->y2_top, w->x2, w->y2_bottom, w->x1, w->y1_bottom,
+                distance_brightness(w->distance, 0.7f));
+    }
+
+    for (int i = 0; i < frame->sprite_count; i++) {
+        const sprite_record_t* e = &frame->sprites[i];
+        int height = e->y_bottom - e->y_top;
+        int width = height * 6 / 10;
+        if (width < 2) width = 2;
+        int b = distance_brightness(e->distance, 0.5f);
+        fprintf(f, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" stroke=\"#%02x%02x00\"/>\n",
+                e->x - width / 2, e->y_top, width, height, b, b);
+    }
+
+    fprintf(f, "</g>\n</svg>\n");
+    return close_output(f);
+}
+
+/**
+ * Helper: Write one trace segment of a .kicad_pcb file.
+ */
+static void write_segment(FILE* f, int x1, int y1, int x2, int y2, double width, const char* layer) {
+    fprintf(f, "  (segment (start %.2f %.2f) (end %.2f %.2f) (width %.2f) (layer \"%s\") (net 1))\n",
+            (x1 - SCREENWIDTH / 2) * KICAD_MM_PER_PIXEL + KICAD_CENTER_X_MM,
+            (y1 - SCREENHEIGHT / 2) * KICAD_MM_PER_PIXEL + KICAD_CENTER_Y_MM,
+            (x2 - SCREENWIDTH / 2) * KICAD_MM_PER_PIXEL + KICAD_CENTER_X_MM,
+            (y2 - SCREENHEIGHT / 2) * KICAD_MM_PER_PIXEL + KICAD_CENTER_Y_MM,
+            width, layer);
+}
+
+/**
+ * Helper: Write a frame as a minimal KiCad board, matching what the plugin
+ * draws live (walls on B.Cu, entities outlined on F.Cu, net DOOM_WORLD).
+ *
+ * Returns: 0 on success, -1 on error
+ */
+static int write_kicad(const doom_frame_t* frame, const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        return -1;
+    }
+
+    fprintf(f, "(kicad_pcb (version 20221018) (generator kidoom)\n");
+    fprintf(f, "  (net 0 \"\")\n  (net 1 \"DOOM_WORLD\")\n");
+
+    for (int i = 0; i < frame->wall_count; i++) {
+        const wall_record_t* w = &frame->walls[i];
+        if (w->silhouette == 0) {
+            continue;
+        }
+        double width = w->distance < KICAD_DISTANCE_THRESHOLD ? KICAD_WIDTH_CLOSE_MM : KICAD_WIDTH_FAR_MM;
+        write_segment(f, w->x1, w->y1_top, w->x2, w->y2_top, width, "B.Cu");
+        write_segment(f, w->x1, w->y1_bottom, w->x2, w->y2_bottom, width, "B.Cu");
+        write_segment(f, w->x1, w->y1_top, w->x1, w->y1_bottom, width, "B.Cu");
+        write_segment(f, w->x2, w->y2_top, w->x2, w->y2_bottom, width, "B.Cu");
+    }
+
+    for (int i = 0; i < frame->sprite_count; i++) {
+        const sprite_record_t* e = &frame->sprites[i];
+        int half = (e->y_bottom - e->y_top) * 3 / 10;
+        int l = e->x - half;
+        int r = e->x + half;
+        write_segment(f, l, e->y_top, r, e->y_top, KICAD_WIDTH_FAR_MM, "F.Cu");
+        write_segment(f, l, e->y_bottom, r, e->y_bottom, KICAD_WIDTH_FAR_MM, "F.Cu");
+        write_segment(f, l, e->y_top, l, e->y_bottom, KICAD_WIDTH_FAR_MM, "F.Cu");
+        write_segment(f, r, e->y_top, r, e->y_bottom, KICAD_WIDTH_FAR_MM, "F.Cu");
+    }
+
+    fprintf(f, ")\n");
+    return close_output(f);
+}
+
+/**
+ * Worker thread: take frames off the queue until told to stop.
+ */
+static void* export_worker(void* arg) {
+    export_worker_t* worker = (export_worker_t*)arg;
+    char path[EXPORT_PATH_MAX + 32];
+
+    doom_sched_apply(SCHED_ROLE_EXPORT, worker->index);
+
+    for (;;) {
+        int waited = 0;
+
+        pthread_mutex_lock(&g_lock);
+        while (g_queue_count == 0 && !g_stopping) {
+            pthread_cond_wait(&g_not_empty, &g_lock);
+            waited = 1;
+        }
+        if (g_queue_count == 0) {
+            pthread_mutex_unlock(&g_lock);
+            break;  /* Stopping and drained */
+        }
+
+        /* An idle worker woken for this frame: queue-to-run delay is its
+         * wake-up latency */
+        if (waited) {
+            doom_sched_record_latency(SCHED_ROLE_EXPORT,
+                                      doom_clock_us() - g_queue_time_us[g_queue_head]);
+        }
+
+        memcpy(&worker->frame, &g_queue[g_queue_head], sizeof(doom_frame_t));
+        g_queue_head = (g_queue_head + 1) % EXPORT_QUEUE_SIZE;
+        g_queue_count--;
+        pthread_cond_signal(&g_not_full);
+        pthread_mutex_unlock(&g_lock);
+
+        int result = 0;
+        if (g_formats & EXPORT_SVG) {
+            snprintf(path, sizeof(path), "%s/frame_%06d.svg", g_dir, worker->frame.frame);
+            result = write_svg(&worker->frame, path);
+        }
+        if (result == 0 && (g_formats & EXPORT_KICAD)) {
+            snprintf(path, sizeof(path), "%s/frame_%06d.kicad_pcb", g_dir, worker->frame.frame);
+            result = write_kicad(&worker->frame, path);
+        }
+        int error = errno;
+
+        pthread_mutex_lock(&g_lock);
+        if (result == 0) {
+            g_frames_written++;
+        } else if (g_frames_failed++ == 0) {
+            /* First failure only - the rest usually fail the same way */
+            fprintf(stderr, "Warning: export could not write %s: %s\n", path, strerror(error));
+        }
+        pthread_mutex_unlock(&g_lock);
+    }
+
+    return NULL;
+}
+
+int doom_export_start(const char* dir, int formats, int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > EXPORT_MAX_THREADS) threads = EXPORT_MAX_THREADS;
+
+    if (mkdir(dir, 0755) < 0 && errno != EEXIST) {
+        fprintf(stderr, "ERROR: Cannot create export directory %s: %s\n", dir, strerror(errno));
+        return -1;
+    }
+
+    snprintf(g_dir, sizeof(g_dir), "%s", dir);
+    g_formats = formats;
+    g_start_us = doom_clock_us();
+
+    for (int i = 0; i < threads; i++) {
+        g_workers[i].index = i;
+        if (pthread_create(&g_workers[i].thread, NULL, export_worker, &g_workers[i]) != 0) {
+            fprintf(stderr, "ERROR: Failed to start export worker %d\n", i);
+            break;
+        }
+        g_thread_count++;
+    }
+    if (g_thread_count == 0) {
+        return -1;
+    }
+
+    g_running = 1;
+    I_AtExit(doom_export_finish, true);
+
+    printf("✓ Exporting %s%s to %s/ (%d threads)\n",
+           (formats & EXPORT_SVG) ? "SVG" : "",
+           (formats & EXPORT_KICAD) ? ((formats & EXPORT_SVG) ? " + kicad_pcb" : "kicad_pcb") : "",
+           dir, g_thread_count);
+    return 0;
+}
+
+void doom_export_frame(const doom_frame_t* frame) {
+    if (!g_running) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_lock);
+    while (g_queue_count == EXPORT_QUEUE_SIZE) {
+        pthread_cond_wait(&g_not_full, &g_lock);
+    }
+
+    int tail = (g_queue_head + g_queue_count) % EXPORT_QUEUE_SIZE;
+    memcpy(&g_queue[tail], frame, sizeof(doom_frame_t));
+    g_queue_time_us[tail] = doom_clock_us();
+    g_queue_count++;
+    pthread_cond_signal(&g_not_empty);
+    pthread_mutex_unlock(&g_lock);
+}
+
+int doom_export_queue_depth(void) {
+    return __atomic_load_n(&g_queue_count, __ATOMIC_RELAXED);
+}
+
+void doom_export_finish(void) {
+    if (!g_running) {
+        return;
+    }
+    g_running = 0;
+
+    pthread_mutex_lock(&g_lock);
+    g_stopping = 1;
+    pthread_cond_broadcast(&g_not_empty);
+    pthread_mutex_unlock(&g_lock);
+
+    for (int i = 0; i < g_thread_count; i++) {
+        pthread_join(g_workers[i].thread, NULL);
+    }
+
+    double elapsed_s = (doom_clock_us() - g_start_us) / 1000000.0;
+    printf("Export: %d frames in %.2fs (%.1f frames/sec) -> %s/\n",
+           g_frames_written, elapsed_s,
+           g_frames_written / (elapsed_s > 0 ? elapsed_s : 1), g_dir);
+    if (g_frames_failed > 0) {
+        printf("Export: %d frames could not be written\n", g_frames_failed);
+    }
+}
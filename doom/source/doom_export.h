@@ -0,0 +1,56 @@
+/**
+ * doom_export.h
+ *
+ * Offline batch export sink.
+ *
+ * Writes every extracted frame to disk as SVG (and optionally a .kicad_pcb
+ * board with one trace per wall edge) instead of sending it to a live
+ * renderer. Formatting and file I/O run on a pool of worker threads, so with
+ * -headless -timedemo a recorded session exports as fast as DOOM can
+ * simulate it - no KiCad, pygame or screenshots involved.
+ */
+
+#ifndef DOOM_EXPORT_H
+#define DOOM_EXPORT_H
+
+#include "doom_frame.h"
+
+/* Output formats (bit flags) */
+#define EXPORT_SVG   0x01
+#define EXPORT_KICAD 0x02
+
+#define EXPORT_DEFAULT_THREADS 4
+#define EXPORT_MAX_THREADS     16
+
+/**
+ * Start the worker pool. Frames are written as <dir>/frame_NNNNNN.svg
+ * (and .kicad_pcb). Registers an exit handler that drains the queue and
+ * prints frames/sec.
+ *
+ * Args:
+ *   dir: Output directory (created if missing)
+ *   formats: EXPORT_SVG and/or EXPORT_KICAD
+ *   threads: Worker count (1..EXPORT_MAX_THREADS)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int doom_export_start(const char* dir, int formats, int threads);
+
+/**
+ * Queue a copy of the frame for export. Blocks only when every queue slot
+ * is taken (workers are behind).
+ */
+void doom_export_frame(const doom_frame_t* frame);
+
+/**
+ * Frames currently waiting for a worker (lock-free snapshot, for stats).
+ */
+int doom_export_queue_depth(void);
+
+/**
+ * Wait for queued frames, stop the workers and print throughput.
+ * Safe to call more than once.
+ */
+void doom_export_finish(void);
+
+#endif /* DOOM_EXPORT_H */
@@ -0,0 +1,47 @@
+/**
+ * doom_frame.h
+ *
+ * Structured frame: the walls and sprites of one rendered view, projected to
+ * screen coordinates. The extractor fills this once per frame; the JSON
+ * writer and the offline export sink both read from it.
+ */
+
+#ifndef DOOM_FRAME_H
+#define DOOM_FRAME_H
+
+#include "doomdef.h"
+#include "r_defs.h"
+#include "r_bsp.h"
+#include "r_things.h"
+
+/* One wall segment (same fields as a "walls" JSON entry) */
+typedef struct {
+    int x1, y1_top, y1_bottom;
+    int x2, y2_top, y2_bottom;
+    int distance;    /* 0 (near) .. 999 (far) */
+    int silhouette;  /* 0 = portal, 1 = lower, 2 = upper, 3 = solid */
+} wall_record_t;
+
+/* One sprite (same fields as an "entities" JSON entry) */
+typedef struct {
+    int x, y_top, y_bottom;
+    int height;
+    int type;
+    int distance;
+    int id;          /* Stable mobj ID, 0 = unknown */
+    int has_prev;
+    int prev[3];     /* x, y_top, y_bottom at the previous tic */
+} sprite_record_t;
+
+typedef struct {
+    int frame;
+    int tic;
+
+    int wall_count;
+    wall_record_t walls[MAXDRAWSEGS];
+
+    int sprite_count;
+    sprite_record_t sprites[MAXVISSPRITES];
+} doom_frame_t;
+
+#endif /* DOOM_FRAME_H */
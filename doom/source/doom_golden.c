@@ -0,0 +1,232 @@
+/**
+ * doom_golden.c
+ *
+ * Canonical frame hashing and golden file handling.
+ */
+
+#include "doom_golden.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "i_system.h"
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME        0x100000001b3ULL
+
+#define WALL_FIELDS   8
+#define SPRITE_FIELDS 6
+
+static FILE* g_file = NULL;
+static char g_path[256];
+static int g_mode = GOLDEN_OFF;
+
+static int g_index = 0;
+static int g_mismatches = 0;
+static int g_first_mismatch = -1;
+static int g_missing = 0;
+
+/* Canonical copies of the current frame */
+static int g_walls[MAXDRAWSEGS][WALL_FIELDS];
+static int g_sprites[MAXVISSPRITES][SPRITE_FIELDS];
+
+/**
+ * Helper: Feed one int32 (little-endian) into an FNV-1a hash.
+ */
+static uint64_t fnv_int(uint64_t hash, int value) {
+    uint32_t v = (uint32_t)value;
+    for (int i = 0; i < 4; i++) {
+        hash ^= (v >> (8 * i)) & 0xff;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Helper: Lexicographic comparison of two integer records.
+ */
+static int compare_fields(const int* a, const int* b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static int compare_walls(const void* a, const void* b) {
+    return compare_fields((const int*)a, (const int*)b, WALL_FIELDS);
+}
+
+static int compare_sprites(const void* a, const void* b) {
+    return compare_fields((const int*)a, (const int*)b, SPRITE_FIELDS);
+}
+
+/**
+ * Helper: Fill g_walls / g_sprites with the sorted canonical records.
+ */
+static void canonicalize(const doom_frame_t* frame) {
+    for (int i = 0; i < frame->wall_count; i++) {
+        const wall_record_t* w = &frame->walls[i];
+        int* c = g_walls[i];
+        c[0] = w->x1;
+        c[1] = w->y1_top;
+        c[2] = w->y1_bottom;
+        c[3] = w->x2;
+        c[4] = w->y2_top;
+        c[5] = w->y2_bottom;
+        c[6] = w->distance;
+        c[7] = w->silhouette;
+    }
+    qsort(g_walls, frame->wall_count, sizeof(g_walls[0]), compare_walls);
+
+    for (int i = 0; i < frame->sprite_count; i++) {
+        const sprite_record_t* e = &frame->sprites[i];
+        int* c = g_sprites[i];
+        c[0] = e->x;
+        c[1] = e->y_top;
+        c[2] = e->y_bottom;
+        c[3] = e->height;
+        c[4] = e->type;
+        c[5] = e->distance;
+    }
+    qsort(g_sprites, frame->sprite_count, sizeof(g_sprites[0]), compare_sprites);
+}
+
+/**
+ * Helper: Write the canonical records of the current frame for diffing.
+ */
+static void dump_frame(const doom_frame_t* frame) {
+    char path[300];
+    snprintf(path, sizeof(path), "%s.frame%d.txt", g_path, g_index);
+
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        return;
+    }
+
+    fprintf(f, "# frame %d tic %d\n", g_index, frame->tic);
+    for (int i = 0; i < frame->wall_count; i++) {
+        fprintf(f, "wall %d:", i);
+        for (int k = 0; k < WALL_FIELDS; k++) fprintf(f, " %d", g_walls[i][k]);
+        fprintf(f, "\n");
+    }
+    for (int i = 0; i < frame->sprite_count; i++) {
+        fprintf(f, "sprite %d:", i);
+        for (int k = 0; k < SPRITE_FIELDS; k++) fprintf(f, " %d", g_sprites[i][k]);
+        fprintf(f, "\n");
+    }
+    fclose(f);
+
+    printf("  Canonical records written to %s\n", path);
+}
+
+void doom_golden_hash(const doom_frame_t* frame, uint64_t* walls_hash, uint64_t* sprites_hash) {
+    canonicalize(frame);
+
+    uint64_t h = fnv_int(FNV_OFFSET_BASIS, frame->wall_count);
+    for (int i = 0; i < frame->wall_count; i++) {
+        for (int k = 0; k < WALL_FIELDS; k++) {
+            h = fnv_int(h, g_walls[i][k]);
+        }
+    }
+    *walls_hash = h;
+
+    h = fnv_int(FNV_OFFSET_BASIS, frame->sprite_count);
+    for (int i = 0; i < frame->sprite_count; i++) {
+        for (int k = 0; k < SPRITE_FIELDS; k++) {
+            h = fnv_int(h, g_sprites[i][k]);
+        }
+    }
+    *sprites_hash = h;
+}
+
+/**
+ * Exit handler: close the file and print the verdict.
+ */
+static void golden_shutdown(void) {
+    if (g_file == NULL) {
+        return;
+    }
+
+    /* Golden frames left over mean the run ended early */
+    if (g_mode == GOLDEN_CHECK) {
+        int index, tic;
+        uint64_t walls_hash, sprites_hash;
+        while (fscanf(g_file, "%d %d %" SCNx64 " %" SCNx64, &index, &tic,
+                      &walls_hash, &sprites_hash) == 4) {
+            g_missing++;
+        }
+    }
+
+    fclose(g_file);
+    g_file = NULL;
+
+    if (g_mode == GOLDEN_WRITE) {
+        printf("Golden: wrote %d frame hashes to %s\n", g_index, g_path);
+        return;
+    }
+
+    if (g_mismatches == 0 && g_missing == 0) {
+        printf("Golden: PASS - %d frames match %s\n", g_index, g_path);
+    } else {
+        printf("Golden: FAIL - %d of %d frames differ, frame count off by %d (first difference at frame %d)\n",
+               g_mismatches, g_index, g_missing, g_first_mismatch);
+    }
+}
+
+int doom_golden_open(const char* path, int mode) {
+    snprintf(g_path, sizeof(g_path), "%s", path);
+    g_mode = mode;
+
+    g_file = fopen(path, mode == GOLDEN_WRITE ? "w" : "r");
+    if (g_file == NULL) {
+        fprintf(stderr, "ERROR: Cannot open golden file %s\n", path);
+        g_mode = GOLDEN_OFF;
+        return -1;
+    }
+
+    I_AtExit(golden_shutdown, true);
+    printf("✓ Golden hashes: %s %s\n", mode == GOLDEN_WRITE ? "writing" : "checking", path);
+    return 0;
+}
+
+void doom_golden_frame(const doom_frame_t* frame) {
+    if (g_file == NULL) {
+        return;
+    }
+
+    uint64_t walls_hash, sprites_hash;
+    doom_golden_hash(frame, &walls_hash, &sprites_hash);
+
+    if (g_mode == GOLDEN_WRITE) {
+        fprintf(g_file, "%d %d %016" PRIx64 " %016" PRIx64 "\n",
+                g_index, frame->tic, walls_hash, sprites_hash);
+        g_index++;
+        return;
+    }
+
+    int index, tic;
+    uint64_t expect_walls, expect_sprites;
+    if (fscanf(g_file, "%d %d %" SCNx64 " %" SCNx64, &index, &tic,
+               &expect_walls, &expect_sprites) != 4) {
+        g_missing++;  /* Run produced more frames than the golden file */
+        g_index++;
+        return;
+    }
+
+    if (walls_hash != expect_walls || sprites_hash != expect_sprites || tic != frame->tic) {
+        if (g_first_mismatch < 0) {
+            g_first_mismatch = g_index;
+            printf("GOLDEN MISMATCH at frame %d (tic %d, expected tic %d):%s%s%s\n",
+                   g_index, frame->tic, tic,
+                   walls_hash != expect_walls ? " walls differ" : "",
+                   sprites_hash != expect_sprites ? " sprites differ" : "",
+                   tic != frame->tic ? " tic differs" : "");
+            dump_frame(frame);
+        }
+        g_mismatches++;
+    }
+    g_index++;
+}
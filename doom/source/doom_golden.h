@@ -0,0 +1,61 @@
+/**
+ * doom_golden.h
+ *
+ * Golden-hash regression oracle for the extraction path.
+ *
+ * Each frame is reduced to a canonical form - walls as their 8 integer
+ * fields, sprites as x, y_top, y_bottom, height, type, distance, each list
+ * sorted lexicographically so emission order (e.g. -depthorder) doesn't
+ * matter - and hashed with 64-bit FNV-1a over little-endian int32 values:
+ *
+ *   walls hash   = FNV1a(wall_count, w0[0..7], w1[0..7], ...)
+ *   sprites hash = FNV1a(sprite_count, s0[0..5], s1[0..5], ...)
+ *
+ * tests/golden_check.py implements the same hash over decoded JSON frames, so
+ * any encoder or transport can be checked against this reference.
+ *
+ * Golden files have one line per extracted frame:
+ *   <index> <tic> <walls hash> <sprites hash>
+ */
+
+#ifndef DOOM_GOLDEN_H
+#define DOOM_GOLDEN_H
+
+#include <stdint.h>
+
+#include "doom_frame.h"
+
+/* Modes */
+#define GOLDEN_OFF    0
+#define GOLDEN_WRITE  1  /* Record hashes to the golden file */
+#define GOLDEN_CHECK  2  /* Compare against the golden file */
+
+/**
+ * Hash the canonical form of a frame.
+ *
+ * Args:
+ *   frame: Extracted frame
+ *   walls_hash: Output - hash of the sorted walls
+ *   sprites_hash: Output - hash of the sorted sprites
+ */
+void doom_golden_hash(const doom_frame_t* frame, uint64_t* walls_hash, uint64_t* sprites_hash);
+
+/**
+ * Open the golden file for writing or checking. Registers an exit handler
+ * that prints the PASS/FAIL summary.
+ *
+ * Args:
+ *   path: Golden file path
+ *   mode: GOLDEN_WRITE or GOLDEN_CHECK
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int doom_golden_open(const char* path, int mode);
+
+/**
+ * Record or check one frame. On the first mismatch, the frame's canonical
+ * records are dumped to <path>.frame<index>.txt for diffing.
+ */
+void doom_golden_frame(const doom_frame_t* frame);
+
+#endif /* DOOM_GOLDEN_H */
@@ -0,0 +1,96 @@
+/**
+ * doom_idle.c
+ *
+ * Frame change signature (FNV-1a 64 over the inputs of the extractor).
+ */
+
+#include "doom_idle.h"
+
+/* Import DOOM's internal rendering structures */
+#include "r_defs.h"
+#include "r_state.h"
+#include "r_things.h"
+#include "p_pspr.h"
+#include "doomstat.h"
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME        0x100000001b3ULL
+
+/* Declare external DOOM variables */
+extern vissprite_t vissprites[MAXVISSPRITES];
+extern vissprite_t* vissprite_p;
+extern int viewwidth;
+extern int viewheight;
+extern int numtextures;  /* r_data.c */
+
+/**
+ * Helper: Fold one 32-bit value into the hash.
+ */
+static uint64_t mix(uint64_t h, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        h ^= (value >> (i * 8)) & 0xff;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+uint64_t doom_idle_signature(int texedges) {
+    uint64_t h = FNV_OFFSET_BASIS;
+
+    /* Game and menu state */
+    h = mix(h, (uint32_t)gamestate);
+    h = mix(h, (uint32_t)menuactive);
+    h = mix(h, (uint32_t)paused);
+    h = mix(h, (uint32_t)automapactive);
+
+    if (gamestate != GS_LEVEL) {
+        return h;
+    }
+
+    /* View (position, angle, and size under -dynres) */
+    h = mix(h, (uint32_t)viewx);
+    h = mix(h, (uint32_t)viewy);
+    h = mix(h, (uint32_t)viewz);
+    h = mix(h, (uint32_t)viewangle);
+    h = mix(h, (uint32_t)viewwidth);
+    h = mix(h, (uint32_t)viewheight);
+
+    /* Sector movers: doors, lifts, floors, crushers, light changes */
+    for (int i = 0; i < numsectors; i++) {
+        const sector_t* sector = &sectors[i];
+        h = mix(h, (uint32_t)sector->floorheight);
+        h = mix(h, (uint32_t)sector->ceilingheight);
+        h = mix(h, (uint32_t)((sector->floorpic << 16) | (sector->ceilingpic & 0xffff)));
+        h = mix(h, (uint32_t)sector->lightlevel);
+    }
+
+    /* Texture edges follow the wall textures: animated walls and scrollers */
+    if (texedges) {
+        for (int i = 0; i < numtextures; i++) {
+            h = mix(h, (uint32_t)texturetranslation[i]);
+        }
+        for (int i = 0; i < numsides; i++) {
+            h = mix(h, (uint32_t)sides[i].textureoffset);
+        }
+    }
+
+    /* Visible things, as projected this frame */
+    int sprite_count = vissprite_p - vissprites;
+    h = mix(h, (uint32_t)sprite_count);
+    for (int i = 0; i < sprite_count && i < MAXVISSPRITES; i++) {
+        const vissprite_t* vis = &vissprites[i];
+        h = mix(h, (uint32_t)((vis->x1 << 16) | (vis->x2 & 0xffff)));
+        h = mix(h, (uint32_t)vis->gz);
+        h = mix(h, (uint32_t)vis->gzt);
+        h = mix(h, (uint32_t)vis->scale);
+        h = mix(h, (uint32_t)vis->mobjtype);
+    }
+
+    /* Weapon bob and state */
+    const pspdef_t* weapon = &players[consoleplayer].psprites[ps_weapon];
+    h = mix(h, (uint32_t)(uintptr_t)weapon->state);
+    h = mix(h, (uint32_t)weapon->sx);
+    h = mix(h, (uint32_t)weapon->sy);
+
+    return h;
+}
@@ -0,0 +1,34 @@
+/**
+ * doom_idle.h
+ *
+ * Cheap world-change detection for idle-frame suppression.
+ *
+ * Everything the vector output depends on - view position and angle, sector
+ * heights and flats (doors, lifts, crushers), the visible sprites, the weapon
+ * and the game/menu state - is folded into one 64-bit signature before any
+ * extraction happens. If the signature matches the previous frame's, the
+ * frame would come out identical and DG_DrawFrame() can skip extraction and
+ * sending altogether.
+ */
+
+#ifndef DOOM_IDLE_H
+#define DOOM_IDLE_H
+
+#include <stdint.h>
+
+/* While idle, a heartbeat goes out at most this often */
+#define IDLE_HEARTBEAT_MS 1000
+
+/**
+ * Compute the change signature of the frame that was just rendered.
+ * Must be called after R_RenderPlayerView() (i.e. from DG_DrawFrame).
+ *
+ * Args:
+ *   texedges: Nonzero under -texedges; also covers wall texture animation
+ *             and scrolling, which move the texture edge lines
+ *
+ * Returns: Signature; equal values mean an identical vector frame
+ */
+uint64_t doom_idle_signature(int texedges);
+
+#endif /* DOOM_IDLE_H */
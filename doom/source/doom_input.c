@@ -0,0 +1,116 @@
+/**
+ * doom_input.c
+ *
+ * Input state snapshot diffing.
+ */
+
+#include "doom_input.h"
+
+#include <string.h>
+
+#define INPUT_QUEUE_SIZE 512  /* Power of two, > one full snapshot of changes */
+
+/* Keys the consumer holds (snapshots and single events), as far as queued
+ * events have told DOOM */
+static uint8_t g_held[INPUT_STATE_BYTES];
+
+/* Keys held in DOOM's own window; DOOM sees a key held while either holds it */
+static uint8_t g_local[INPUT_STATE_BYTES];
+
+static int g_have_seq = 0;
+static uint32_t g_last_seq = 0;
+
+static unsigned short g_queue[INPUT_QUEUE_SIZE];
+static unsigned int g_queue_read = 0;
+static unsigned int g_queue_write = 0;
+
+/**
+ * Helper: Set or clear a key in a state bitmap.
+ */
+static void set_key(uint8_t* state, int pressed, int key) {
+    if (pressed) {
+        state[key >> 3] |= (uint8_t)(1 << (key & 7));
+    } else {
+        state[key >> 3] &= (uint8_t)~(1 << (key & 7));
+    }
+}
+
+/**
+ * Helper: Queue one consumer key event and update the held state. Nothing
+ * is queued for a key the window holds: DOOM already sees it held.
+ *
+ * Returns: 1 if done, 0 if the queue is full
+ */
+static int queue_event(int pressed, int key) {
+    if ((g_local[key >> 3] & (1 << (key & 7))) == 0) {
+        if (g_queue_write - g_queue_read >= INPUT_QUEUE_SIZE) {
+            return 0;
+        }
+        g_queue[g_queue_write++ % INPUT_QUEUE_SIZE] = (unsigned short)((pressed << 8) | key);
+    }
+    set_key(g_held, pressed, key);
+    return 1;
+}
+
+int doom_input_apply_state(const uint8_t* payload, uint32_t len) {
+    uint32_t seq;
+    const uint8_t* keys = payload + 4;
+
+    if (len != INPUT_STATE_SIZE) {
+        return -1;
+    }
+
+    memcpy(&seq, payload, sizeof(seq));
+    if (g_have_seq && (int32_t)(seq - g_last_seq) <= 0) {
+        return -1;  /* Older than (or same as) what we applied */
+    }
+    g_have_seq = 1;
+    g_last_seq = seq;
+
+    /* Releases first, so a key swap never has both held at once */
+    int queued = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        int pressed = pass;
+        for (int i = 0; i < INPUT_STATE_BYTES; i++) {
+            uint8_t changed = keys[i] ^ g_held[i];
+            if (changed == 0) {
+                continue;
+            }
+            uint8_t wanted = pressed ? (changed & keys[i]) : (changed & g_held[i]);
+            for (int bit = 0; wanted != 0; bit++, wanted >>= 1) {
+                if ((wanted & 1) == 0) {
+                    continue;
+                }
+                if (!queue_event(pressed, i * 8 + bit)) {
+                    return queued;  /* Next snapshot picks up the rest */
+                }
+                queued++;
+            }
+        }
+    }
+
+    return queued;
+}
+
+int doom_input_note_key(int pressed, unsigned char key) {
+    int local = (g_local[key >> 3] & (1 << (key & 7))) != 0;
+    set_key(g_held, pressed, key);
+    return pressed || !local;
+}
+
+int doom_input_local_key(int pressed, unsigned char key) {
+    int held = (g_held[key >> 3] & (1 << (key & 7))) != 0;
+    set_key(g_local, pressed, key);
+    return pressed || !held;
+}
+
+int doom_input_next_event(int* pressed, unsigned char* key) {
+    if (g_queue_read == g_queue_write) {
+        return 0;
+    }
+
+    unsigned short data = g_queue[g_queue_read++ % INPUT_QUEUE_SIZE];
+    *pressed = data >> 8;
+    *key = data & 0xFF;
+    return 1;
+}
@@ -0,0 +1,70 @@
+/**
+ * doom_input.h
+ *
+ * Input state snapshots (MSG_INPUT_STATE) turned into DOOM key events.
+ *
+ * Instead of one message per press/release, the consumer sends the set of
+ * held DOOM keys as a bitmap with a sequence number, whenever it changes
+ * and again periodically. Each snapshot is diffed against the keys DOOM
+ * currently believes are held, and the differences become press/release
+ * events for DG_GetKey(). A lost snapshot is corrected by the next one and
+ * an out-of-date one (lower sequence number) is ignored, so keys can't get
+ * stuck on a lossy or coalescing transport.
+ *
+ * Payload: [uint32 seq][INPUT_STATE_BYTES bitmap], bit k of byte k/8 set
+ * while DOOM key k is held.
+ *
+ * Keys held in DOOM's own window are tracked separately, so a snapshot
+ * without them doesn't release them: DOOM sees a key as held while the
+ * consumer or the window holds it, and only the last release reaches it.
+ */
+
+#ifndef DOOM_INPUT_H
+#define DOOM_INPUT_H
+
+#include <stdint.h>
+
+#define INPUT_KEY_COUNT     256
+#define INPUT_STATE_BYTES   (INPUT_KEY_COUNT / 8)
+#define INPUT_STATE_SIZE    (4 + INPUT_STATE_BYTES)
+
+/**
+ * Apply an input state snapshot.
+ *
+ * Args:
+ *   payload: MSG_INPUT_STATE payload
+ *   len: Payload length (must be INPUT_STATE_SIZE)
+ *
+ * Returns: Number of key events queued, or -1 if malformed / out of date
+ */
+int doom_input_apply_state(const uint8_t* payload, uint32_t len);
+
+/**
+ * Record an individual key event (MSG_KEY_EVENT), so that snapshots mixed
+ * with legacy events diff against the right state.
+ *
+ * Returns: 1 if DOOM should get the event, 0 for a release of a key the
+ *          window still holds
+ */
+int doom_input_note_key(int pressed, unsigned char key);
+
+/**
+ * Record a key event from DOOM's own window (SDL).
+ *
+ * Returns: 1 if DOOM should get the event, 0 for a release of a key the
+ *          consumer still holds
+ */
+int doom_input_local_key(int pressed, unsigned char key);
+
+/**
+ * Take the next event produced by a snapshot.
+ *
+ * Args:
+ *   pressed: Output - 1 if key pressed, 0 if released
+ *   key: Output - DOOM key code
+ *
+ * Returns: 1 if an event was returned, 0 if none are pending
+ */
+int doom_input_next_event(int* pressed, unsigned char* key);
+
+#endif /* DOOM_INPUT_H */
@@ -0,0 +1,220 @@
+/**
+ * doom_json.c
+ *
+ * Fixed-schema JSON emitter (byte-identical to the old snprintf() output).
+ */
+
+#include "doom_json.h"
+
+#include <string.h>
+
+/* Longest integer text: "-2147483648" (11), UINT64_MAX (20) */
+#define JSON_INT_MAX 20
+
+/* "00" "01" ... "99" */
+static const char g_digits[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * Helper: Write the decimal digits of value so they end just before end.
+ * Returns the first digit.
+ */
+static char* format_u64(char* end, uint64_t value) {
+    char* p = end;
+    while (value >= 100) {
+        unsigned int pair = (unsigned int)(value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        p[0] = g_digits[pair];
+        p[1] = g_digits[pair + 1];
+    }
+    if (value >= 10) {
+        p -= 2;
+        p[0] = g_digits[value * 2];
+        p[1] = g_digits[value * 2 + 1];
+    } else {
+        *--p = (char)('0' + value);
+    }
+    return p;
+}
+
+/**
+ * Helper: Same as format_u64 for 32-bit values (cheaper division).
+ */
+static char* format_u32(char* end, uint32_t value) {
+    char* p = end;
+    while (value >= 100) {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        p[0] = g_digits[pair];
+        p[1] = g_digits[pair + 1];
+    }
+    if (value >= 10) {
+        p -= 2;
+        p[0] = g_digits[value * 2];
+        p[1] = g_digits[value * 2 + 1];
+    } else {
+        *--p = (char)('0' + value);
+    }
+    return p;
+}
+
+/**
+ * Helper: Reserve n bytes. Returns where to write, or NULL (and sets
+ * overflow) if they don't fit.
+ */
+static char* reserve(json_writer_t* w, size_t n) {
+    if (w->overflow || w->size - w->len < n) {
+        w->overflow = 1;
+        return NULL;
+    }
+    return w->buf + w->len;
+}
+
+/**
+ * Helper: Append a signed integer (no bounds check - caller reserved).
+ */
+static char* put_int(char* out, int value) {
+    char tmp[JSON_INT_MAX];
+    char* end = tmp + sizeof(tmp);
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    char* p = format_u32(end, magnitude);
+    if (value < 0) {
+        *--p = '-';
+    }
+    size_t n = end - p;
+    memcpy(out, p, n);
+    return out + n;
+}
+
+void doom_json_init(json_writer_t* w, char* buf, size_t size) {
+    w->buf = buf;
+    w->size = size;
+    w->len = 0;
+    w->overflow = 0;
+}
+
+void doom_json_append(json_writer_t* w, const char* s, size_t n) {
+    char* out = reserve(w, n);
+    if (out == NULL) {
+        return;
+    }
+    memcpy(out, s, n);
+    w->len += n;
+}
+
+void doom_json_char(json_writer_t* w, char c) {
+    char* out = reserve(w, 1);
+    if (out == NULL) {
+        return;
+    }
+    *out = c;
+    w->len++;
+}
+
+void doom_json_int(json_writer_t* w, int value) {
+    char* out = reserve(w, JSON_INT_MAX);
+    if (out == NULL) {
+        return;
+    }
+    w->len = put_int(out, value) - w->buf;
+}
+
+void doom_json_uint(json_writer_t* w, uint32_t value) {
+    char tmp[JSON_INT_MAX];
+    char* end = tmp + sizeof(tmp);
+    char* p = format_u32(end, value);
+    doom_json_append(w, p, end - p);
+}
+
+void doom_json_u64(json_writer_t* w, uint64_t value) {
+    char tmp[JSON_INT_MAX];
+    char* end = tmp + sizeof(tmp);
+    char* p = format_u64(end, value);
+    doom_json_append(w, p, end - p);
+}
+
+void doom_json_wall(json_writer_t* w, const wall_record_t* wall, int first) {
+    /* 8 integers, 7 commas, brackets and a leading comma */
+    char* out = reserve(w, 8 * JSON_INT_MAX + 10);
+    if (out == NULL) {
+        return;
+    }
+
+    if (!first) *out++ = ',';
+    *out++ = '[';
+    out = put_int(out, wall->x1);          *out++ = ',';
+    out = put_int(out, wall->y1_top);      *out++ = ',';
+    out = put_int(out, wall->y1_bottom);   *out++ = ',';
+    out = put_int(out, wall->x2);          *out++ = ',';
+    out = put_int(out, wall->y2_top);      *out++ = ',';
+    out = put_int(out, wall->y2_bottom);   *out++ = ',';
+    out = put_int(out, wall->distance);    *out++ = ',';
+    out = put_int(out, wall->silhouette);
+    *out++ = ']';
+
+    w->len = out - w->buf;
+}
+
+void doom_json_entity(json_writer_t* w, const sprite_record_t* entity, int first) {
+    static const char k_x[] = "{\"x\":";
+    static const char k_y_top[] = ",\"y_top\":";
+    static const char k_y_bottom[] = ",\"y_bottom\":";
+    static const char k_height[] = ",\"height\":";
+    static const char k_type[] = ",\"type\":";
+    static const char k_distance[] = ",\"distance\":";
+    static const char k_id[] = ",\"id\":";
+    static const char k_prev[] = ",\"prev\":[";
+
+    /* Keys + 10 integers + punctuation, with room to spare */
+    char* out = reserve(w, 128 + 10 * JSON_INT_MAX);
+    if (out == NULL) {
+        return;
+    }
+
+#define PUT_KEY(k) do { memcpy(out, k, sizeof(k) - 1); out += sizeof(k) - 1; } while (0)
+    if (!first) *out++ = ',';
+    PUT_KEY(k_x);        out = put_int(out, entity->x);
+    PUT_KEY(k_y_top);    out = put_int(out, entity->y_top);
+    PUT_KEY(k_y_bottom); out = put_int(out, entity->y_bottom);
+    PUT_KEY(k_height);   out = put_int(out, entity->height);
+    PUT_KEY(k_type);     out = put_int(out, entity->type);
+    PUT_KEY(k_distance); out = put_int(out, entity->distance);
+    if (entity->id != 0) {
+        PUT_KEY(k_id);   out = put_int(out, entity->id);
+    }
+    if (entity->has_prev) {
+        PUT_KEY(k_prev);
+        out = put_int(out, entity->prev[0]); *out++ = ',';
+        out = put_int(out, entity->prev[1]); *out++ = ',';
+        out = put_int(out, entity->prev[2]); *out++ = ']';
+    }
+    *out++ = '}';
+#undef PUT_KEY
+
+    w->len = out - w->buf;
+}
+
+void doom_json_points(json_writer_t* w, const short (*points)[2], int count) {
+    for (int i = 0; i < count; i++) {
+        char* out = reserve(w, 2 * JSON_INT_MAX + 2);
+        if (out == NULL) {
+            return;
+        }
+        if (i > 0) *out++ = ',';
+        out = put_int(out, points[i][0]);
+        *out++ = ',';
+        out = put_int(out, points[i][1]);
+        w->len = out - w->buf;
+    }
+}
@@ -0,0 +1,69 @@
+/**
+ * doom_json.h
+ *
+ * Allocation-free JSON writer for the frame schema.
+ *
+ * snprintf() parses its format string and goes through locale-aware integer
+ * formatting for every field; a frame has a few thousand of them. This writer
+ * appends into a caller-owned buffer with precomputed literal fragments and
+ * a two-digits-per-step integer conversion, producing exactly the bytes the
+ * snprintf() code did. Appends are bounds-checked: once something doesn't
+ * fit, the writer stops and sets overflow (output is then truncated).
+ */
+
+#ifndef DOOM_JSON_H
+#define DOOM_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "doom_frame.h"
+
+typedef struct {
+    char* buf;
+    size_t size;
+    size_t len;
+    int overflow;  /* An append didn't fit */
+} json_writer_t;
+
+/* Append a string literal (length known at compile time) */
+#define JSON_LITERAL(w, s) doom_json_append((w), (s), sizeof(s) - 1)
+
+/**
+ * Start writing into buf (size bytes). The buffer is reused, never
+ * allocated or NUL-terminated.
+ */
+void doom_json_init(json_writer_t* w, char* buf, size_t size);
+
+/**
+ * Append raw bytes / a single character.
+ */
+void doom_json_append(json_writer_t* w, const char* s, size_t n);
+void doom_json_char(json_writer_t* w, char c);
+
+/**
+ * Append an integer in decimal (same text as %d / %u / %llu).
+ */
+void doom_json_int(json_writer_t* w, int value);
+void doom_json_uint(json_writer_t* w, uint32_t value);
+void doom_json_u64(json_writer_t* w, uint64_t value);
+
+/**
+ * Append one "walls" entry: [x1,y1_top,y1_bottom,x2,y2_top,y2_bottom,distance,silhouette]
+ *
+ * Args:
+ *   first: Non-zero for the first entry of the list (no leading comma)
+ */
+void doom_json_wall(json_writer_t* w, const wall_record_t* wall, int first);
+
+/**
+ * Append one "entities" entry, including "id" / "prev" when present.
+ */
+void doom_json_entity(json_writer_t* w, const sprite_record_t* entity, int first);
+
+/**
+ * Append (x, y) pairs as a flat list body: x,y,x,y,...
+ */
+void doom_json_points(json_writer_t* w, const short (*points)[2], int count);
+
+#endif /* DOOM_JSON_H */
@@ -0,0 +1,112 @@
+/**
+ * doom_motion.c
+ *
+ * Previous-tic history. Sprites are kept in two small open-addressing hash
+ * tables keyed by mobj ID: one being filled for the current frame and one
+ * holding the previous tic. Tables swap when the tic advances.
+ */
+
+#include "doom_motion.h"
+
+#include <string.h>
+
+/* Power of two, comfortably above MAXVISSPRITES (128) */
+#define MOTION_TABLE_SIZE 512
+
+typedef struct {
+    int id;           /* 0 = empty slot */
+    int pos[3];       /* x, y_top, y_bottom */
+} motion_sprite_t;
+
+typedef struct {
+    motion_view_t view;
+    int has_view;
+    int count;
+    motion_sprite_t sprites[MOTION_TABLE_SIZE];
+} motion_frame_t;
+
+static motion_frame_t g_frames[2];
+static motion_frame_t* g_cur = &g_frames[0];
+static motion_frame_t* g_prev = &g_frames[1];
+static int g_started = 0;
+
+/**
+ * Helper: Find the slot for id (existing entry or the empty slot to use).
+ */
+static motion_sprite_t* find_slot(motion_frame_t* frame, int id) {
+    unsigned int i = ((unsigned int)id * 2654435761u) & (MOTION_TABLE_SIZE - 1);
+
+    while (frame->sprites[i].id != 0 && frame->sprites[i].id != id) {
+        i = (i + 1) & (MOTION_TABLE_SIZE - 1);
+    }
+    return &frame->sprites[i];
+}
+
+/**
+ * Helper: Empty a frame record.
+ */
+static void clear_frame(motion_frame_t* frame) {
+    frame->has_view = 0;
+    frame->count = 0;
+    memset(frame->sprites, 0, sizeof(frame->sprites));
+}
+
+void doom_motion_begin_frame(int tic) {
+    if (g_started && g_cur->view.tic != tic) {
+        /* Tic advanced - current frame becomes history */
+        motion_frame_t* tmp = g_prev;
+        g_prev = g_cur;
+        g_cur = tmp;
+    }
+
+    clear_frame(g_cur);
+    g_cur->view.tic = tic;
+    g_started = 1;
+}
+
+void doom_motion_record_view(fixed_t x, fixed_t y, fixed_t z, angle_t angle) {
+    g_cur->view.x = x;
+    g_cur->view.y = y;
+    g_cur->view.z = z;
+    g_cur->view.angle = angle;
+    g_cur->has_view = 1;
+}
+
+const motion_view_t* doom_motion_prev_view(void) {
+    if (!g_prev->has_view) {
+        return NULL;
+    }
+    return &g_prev->view;
+}
+
+void doom_motion_record_sprite(int id, int x, int y_top, int y_bottom) {
+    /* Keep the table at most half full so probes stay short */
+    if (id == 0 || g_cur->count >= MOTION_TABLE_SIZE / 2) {
+        return;
+    }
+
+    motion_sprite_t* slot = find_slot(g_cur, id);
+    if (slot->id == 0) {
+        slot->id = id;
+        g_cur->count++;
+    }
+    slot->pos[0] = x;
+    slot->pos[1] = y_top;
+    slot->pos[2] = y_bottom;
+}
+
+int doom_motion_prev_sprite(int id, int out[3]) {
+    if (id == 0) {
+        return 0;
+    }
+
+    motion_sprite_t* slot = find_slot(g_prev, id);
+    if (slot->id == 0) {
+        return 0;
+    }
+
+    out[0] = slot->pos[0];
+    out[1] = slot->pos[1];
+    out[2] = slot->pos[2];
+    return 1;
+}
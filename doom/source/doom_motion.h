@@ -0,0 +1,73 @@
+/**
+ * doom_motion.h
+ *
+ * Previous-tic history for consumer-side interpolation.
+ *
+ * DOOM simulates at 35 tics/sec while consumers redraw on their own timers.
+ * Each frame carries the current tic; this module remembers what the view and
+ * each identified sprite looked like at the last *earlier* tic that was drawn,
+ * so consumers get two samples (and their tic distance) to interpolate or
+ * extrapolate between.
+ *
+ * Sprite history needs stable IDs, which vissprites only carry when the
+ * engine is built with patches/mobj_ids.patch (-DKIDOOM_MOBJ_IDS).
+ */
+
+#ifndef DOOM_MOTION_H
+#define DOOM_MOTION_H
+
+#include "m_fixed.h"
+#include "tables.h"
+
+/* View state at one tic (world coordinates, 16.16 fixed point) */
+typedef struct {
+    int tic;
+    fixed_t x;
+    fixed_t y;
+    fixed_t z;        /* Eye height (viewz) */
+    angle_t angle;    /* Binary angle: 0x40000000 = 90 degrees */
+} motion_view_t;
+
+/**
+ * Start recording a frame. If the tic differs from the previously recorded
+ * frame, that frame becomes the "previous tic" history; redrawing the same
+ * tic keeps the older history.
+ *
+ * Args:
+ *   tic: Current game tic (gametic)
+ */
+void doom_motion_begin_frame(int tic);
+
+/**
+ * Record the view of the current frame.
+ */
+void doom_motion_record_view(fixed_t x, fixed_t y, fixed_t z, angle_t angle);
+
+/**
+ * Get the view at the previous tic.
+ *
+ * Returns: Previous view, or NULL if no earlier tic has been recorded
+ */
+const motion_view_t* doom_motion_prev_view(void);
+
+/**
+ * Record the screen position of an identified sprite in the current frame.
+ *
+ * Args:
+ *   id: Stable mobj ID (0 = unknown, ignored)
+ *   x, y_top, y_bottom: Screen position as sent in the frame
+ */
+void doom_motion_record_sprite(int id, int x, int y_top, int y_bottom);
+
+/**
+ * Look up a sprite's screen position at the previous tic.
+ *
+ * Args:
+ *   id: Stable mobj ID
+ *   out: Output - x, y_top, y_bottom
+ *
+ * Returns: 1 if found, 0 if the sprite wasn't visible at the previous tic
+ */
+int doom_motion_prev_sprite(int id, int out[3]);
+
+#endif /* DOOM_MOTION_H */
@@ -0,0 +1,131 @@
+/**
+ * doom_pacing.c
+ *
+ * Consumer pickup phase tracking and the just-in-time frame delay.
+ */
+
+#include "doom_pacing.h"
+
+#include <stdio.h>
+
+/* Averages over roughly the last 8 samples */
+#define PACING_AVERAGE_SHIFT 3
+
+/* Phase corrections: move 1/4 of the way to each measured pickup */
+#define PACING_PHASE_SHIFT 2
+
+/* Consumer interval when it doesn't report one (KiCad's 33 ms timer) */
+#define PACING_DEFAULT_INTERVAL_US 33333
+
+typedef struct {
+    int frame;          /* Frame number + 1 (0 = empty slot) */
+    uint64_t sent_us;
+} pacing_sent_t;
+
+static int g_enabled = 0;
+
+static pacing_sent_t g_sent[PACING_HISTORY];
+static int64_t g_work_us = 0;
+
+/* Consumer pickup phase in DOOM's clock */
+static int g_have_phase = 0;
+static uint64_t g_pickup_us = 0;
+static uint64_t g_interval_us = PACING_DEFAULT_INTERVAL_US;
+static uint64_t g_feedback_us = 0;
+
+static int64_t g_queue_us = 0;
+static int64_t g_present_us = 0;
+static uint64_t g_delay_us = 0;
+static uint64_t g_reports = 0;
+
+void doom_pacing_start(void) {
+    g_enabled = 1;
+    printf("✓ Just-in-time pacing (finish %d ms before consumer pickup)\n",
+           PACING_MARGIN_US / 1000);
+}
+
+void doom_pacing_frame_sent(int frame, uint64_t sent_us, uint64_t work_us) {
+    pacing_sent_t* slot = &g_sent[frame % PACING_HISTORY];
+    slot->frame = frame + 1;
+    slot->sent_us = sent_us;
+    g_work_us += ((int64_t)work_us - g_work_us) >> PACING_AVERAGE_SHIFT;
+}
+
+void doom_pacing_feedback(int frame, uint64_t wait_us, uint64_t decode_us,
+                          uint64_t render_us, uint64_t interval_us) {
+    if (frame < 0) {
+        return;
+    }
+    const pacing_sent_t* slot = &g_sent[frame % PACING_HISTORY];
+    if (slot->frame != frame + 1) {
+        return;  /* Too old, or never sent */
+    }
+
+    uint64_t queue_us = decode_us + wait_us;
+    uint64_t pickup_us = slot->sent_us + queue_us;
+
+    if (interval_us > 0) {
+        g_interval_us = interval_us;
+    }
+
+    if (!g_have_phase) {
+        g_pickup_us = pickup_us;
+        g_queue_us = queue_us;
+        g_present_us = render_us;
+        g_have_phase = 1;
+    } else {
+        /* Nearest predicted pickup, then nudge the phase towards the sample */
+        int64_t since = (int64_t)(pickup_us - g_pickup_us);
+        int64_t periods = (since + (int64_t)g_interval_us / 2) / (int64_t)g_interval_us;
+        if (since < 0) {
+            periods = -((-since + (int64_t)g_interval_us / 2) / (int64_t)g_interval_us);
+        }
+        uint64_t predicted = g_pickup_us + periods * (int64_t)g_interval_us;
+        g_pickup_us = predicted + ((int64_t)(pickup_us - predicted) >> PACING_PHASE_SHIFT);
+
+        g_queue_us += ((int64_t)queue_us - g_queue_us) >> PACING_AVERAGE_SHIFT;
+        g_present_us += ((int64_t)render_us - g_present_us) >> PACING_AVERAGE_SHIFT;
+    }
+
+    g_feedback_us = pickup_us;
+    g_reports++;
+}
+
+uint64_t doom_pacing_delay_us(uint64_t now_us) {
+    g_delay_us = 0;
+    if (!g_enabled || !g_have_phase || now_us - g_feedback_us > PACING_STALE_US) {
+        return 0;
+    }
+
+    /* Earliest pickup the next frame can still make, and when to start it */
+    uint64_t ready_us = now_us + (uint64_t)g_work_us + PACING_MARGIN_US;
+    uint64_t next_us = g_pickup_us;
+    if (next_us < ready_us) {
+        next_us += ((ready_us - next_us) / g_interval_us + 1) * g_interval_us;
+    }
+
+    uint64_t start_us = next_us - (uint64_t)g_work_us - PACING_MARGIN_US;
+    if (start_us <= now_us) {
+        return 0;
+    }
+    g_delay_us = start_us - now_us;
+    return g_delay_us;
+}
+
+uint64_t doom_pacing_queue_us(void) {
+    return g_have_phase ? (uint64_t)g_queue_us : 0;
+}
+
+uint64_t doom_pacing_present_us(void) {
+    return g_have_phase ? (uint64_t)g_present_us : 0;
+}
+
+void doom_pacing_report(void) {
+    if (!g_have_phase) {
+        return;
+    }
+    printf("Pacing: consumer queue %.1f ms, present %.1f ms, interval %.1f ms | "
+           "work %.1f ms, delay %.1f ms (%llu reports)\n",
+           g_queue_us / 1000.0, g_present_us / 1000.0, g_interval_us / 1000.0,
+           g_work_us / 1000.0, g_delay_us / 1000.0, (unsigned long long)g_reports);
+}
@@ -0,0 +1,83 @@
+/**
+ * doom_pacing.h
+ *
+ * Just-in-time frame pacing from consumer present feedback.
+ *
+ * Consumers pick frames up on their own timer (KiCad refreshes every 33 ms),
+ * so a frame finished right after a pickup waits in the socket for most of
+ * an interval. With MSG_PRESENT_FEEDBACK the consumer reports, per frame it
+ * presented, how long the frame waited before its timer picked it up and
+ * how long decoding and rendering took. From DOOM's own send time that gives
+ * the consumer's pickup phase in DOOM's clock (no shared clock needed).
+ *
+ * The controller tracks that phase with a simple phase-locked loop and, with
+ * -pacing, sleeps after each frame so that the next one (tics, 3D render,
+ * extraction, send) finishes PACING_MARGIN_US before the next pickup. Tics
+ * and input are then processed as late as possible, which removes most of
+ * the socket wait without raising the frame rate. The queueing delay
+ * consumers report is tracked either way.
+ */
+
+#ifndef DOOM_PACING_H
+#define DOOM_PACING_H
+
+#include <stdint.h>
+
+#define PACING_HISTORY      64     /* Frames whose send time is remembered */
+#define PACING_MARGIN_US    2000   /* Finish this long before the pickup */
+#define PACING_STALE_US     500000 /* No feedback for this long: stop delaying */
+
+/**
+ * Enable the just-in-time delay (feedback is always accepted).
+ */
+void doom_pacing_start(void);
+
+/**
+ * Remember when a frame finished sending.
+ *
+ * Args:
+ *   frame: Frame number (the "frame" field consumers echo back)
+ *   sent_us: doom_clock_us() after the send
+ *   work_us: Tics + render + extract + send time of the frame
+ */
+void doom_pacing_frame_sent(int frame, uint64_t sent_us, uint64_t work_us);
+
+/**
+ * Apply one MSG_PRESENT_FEEDBACK report.
+ *
+ * Args:
+ *   frame: Frame the consumer presented
+ *   wait_us: Time the frame waited in the consumer before its timer took it
+ *   decode_us: Time the consumer spent decoding it
+ *   render_us: Time from pickup to the finished present
+ *   interval_us: Consumer refresh interval (0 = unknown)
+ */
+void doom_pacing_feedback(int frame, uint64_t wait_us, uint64_t decode_us,
+                          uint64_t render_us, uint64_t interval_us);
+
+/**
+ * How long to sleep before starting the next frame (0 when disabled, before
+ * the first feedback, or when feedback has gone stale).
+ *
+ * Args:
+ *   now_us: doom_clock_us()
+ */
+uint64_t doom_pacing_delay_us(uint64_t now_us);
+
+/**
+ * Averaged queueing delay (send -> consumer pickup) consumers reported,
+ * in microseconds; 0 before the first feedback.
+ */
+uint64_t doom_pacing_queue_us(void);
+
+/**
+ * Averaged consumer present time (pickup -> presented), in microseconds.
+ */
+uint64_t doom_pacing_present_us(void);
+
+/**
+ * Print the pacing summary (for the periodic stats line).
+ */
+void doom_pacing_report(void);
+
+#endif /* DOOM_PACING_H */
@@ -0,0 +1,333 @@
+/**
+ * doom_prefetch.c
+ *
+ * Next-level lump prefetch on a worker thread.
+ *
+ * Every lump has a state byte: queued by the worker, then ready once its
+ * buffer is filled (published with release ordering). W_ReadLump() only
+ * takes ready lumps and reads everything else from the WAD itself, so a
+ * level that starts before the worker is done just gets a partial hit.
+ */
+
+#include "doom_prefetch.h"
+#include "doom_clock.h"
+#include "doom_sched.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "doomdata.h"
+#include "doomstat.h"
+#include "i_swap.h"
+#include "i_system.h"
+#include "info.h"
+#include "m_argv.h"
+#include "r_data.h"
+#include "r_state.h"
+#include "w_wad.h"
+
+#ifdef KIDOOM_LEVEL_PREFETCH
+
+#define LUMP_NONE   0
+#define LUMP_QUEUED 1
+#define LUMP_READY  2
+
+#define MAP_LUMPS   10  /* THINGS .. BLOCKMAP after the map marker */
+
+typedef struct {
+    wad_file_t* wad_file;
+    char* path;
+    FILE* stream;  /* Worker's own handle */
+} prefetch_wad_t;
+
+/* Hooks defined by patches/level_prefetch.patch (w_wad.c, r_data.c) */
+extern void (*kidoom_prefetch_addfile) (wad_file_t* wad_file, char* filename);
+extern boolean (*kidoom_prefetch_read) (unsigned int lump, void* dest);
+extern int R_TexturePatchLumps(int texnum, int* lumps, int max);
+
+static prefetch_wad_t g_wads[PREFETCH_MAX_WADS];
+static int g_wad_count = 0;
+
+/* Per lump (numlumps entries, allocated with the first prefetch) */
+static unsigned char* g_state = NULL;
+static void** g_data = NULL;
+
+static pthread_t g_thread;
+static int g_active = 0;
+static int g_stop = 0;
+static int g_started = 0;     /* This intermission was handled */
+static char g_map_name[9];
+static int g_map_lump = -1;   /* Map being prefetched, -1 = none */
+static int g_graphics = 0;
+
+/* Worker results (read after the join) */
+static int g_fetched = 0;
+static size_t g_fetched_bytes = 0;
+static uint64_t g_fetch_us = 0;
+
+/* Lumps W_ReadLump() took from memory (game thread) */
+static int g_served = 0;
+
+/**
+ * Helper: Remember which file a WAD was opened from.
+ */
+static void prefetch_addfile(wad_file_t* wad_file, char* filename) {
+    if (g_wad_count >= PREFETCH_MAX_WADS) {
+        return;
+    }
+    g_wads[g_wad_count].wad_file = wad_file;
+    g_wads[g_wad_count].path = strdup(filename);
+    g_wads[g_wad_count].stream = NULL;
+    g_wad_count++;
+}
+
+static boolean prefetch_read(unsigned int lump, void* dest) {
+    if (g_state == NULL || __atomic_load_n(&g_state[lump], __ATOMIC_ACQUIRE) != LUMP_READY) {
+        return false;
+    }
+    memcpy(dest, g_data[lump], lumpinfo[lump].size);
+    g_served++;
+    return true;
+}
+
+/**
+ * Helper: Worker's file handle for a lump (NULL for unknown WADs).
+ */
+static FILE* lump_stream(const lumpinfo_t* l) {
+    for (int i = 0; i < g_wad_count; i++) {
+        if (g_wads[i].wad_file != l->wad_file) {
+            continue;
+        }
+        if (g_wads[i].stream == NULL) {
+            g_wads[i].stream = fopen(g_wads[i].path, "rb");
+        }
+        return g_wads[i].stream;
+    }
+    return NULL;
+}
+
+/**
+ * Helper: Read one lump into memory and publish it (worker thread). Lumps
+ * already fetched, past the byte budget or unreadable are skipped.
+ */
+static void fetch_lump(int lump) {
+    if (lump < 0 || (unsigned int)lump >= numlumps || g_state[lump] != LUMP_NONE ||
+        __atomic_load_n(&g_stop, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    const lumpinfo_t* l = &lumpinfo[lump];
+    if (l->size <= 0 || g_fetched_bytes + l->size > PREFETCH_MAX_BYTES) {
+        return;
+    }
+    g_state[lump] = LUMP_QUEUED;
+
+    FILE* stream = lump_stream(l);
+    void* data = malloc(l->size);
+    if (stream == NULL || data == NULL ||
+        fseek(stream, l->position, SEEK_SET) != 0 ||
+        fread(data, 1, l->size, stream) != (size_t)l->size) {
+        free(data);
+        return;
+    }
+
+    g_data[lump] = data;
+    __atomic_store_n(&g_state[lump], LUMP_READY, __ATOMIC_RELEASE);
+    g_fetched++;
+    g_fetched_bytes += l->size;
+}
+
+/**
+ * Helper: Fetch a flat by name (SECTORS floorpic / ceilingpic).
+ */
+static void fetch_flat(const char* name) {
+    char flat[9];
+    memcpy(flat, name, 8);
+    flat[8] = '\0';
+    fetch_lump(W_CheckNumForName(flat));
+}
+
+/**
+ * Helper: Fetch the patches of a texture by name (SIDEDEFS).
+ */
+static void fetch_texture(const char* name) {
+    char texture[9];
+    memcpy(texture, name, 8);
+    texture[8] = '\0';
+
+    int texnum = R_CheckTextureNumForName(texture);
+    if (texnum <= 0) {
+        return;  /* "-" or unknown */
+    }
+
+    int lumps[PREFETCH_MAX_PATCHES];
+    int count = R_TexturePatchLumps(texnum, lumps, PREFETCH_MAX_PATCHES);
+    for (int i = 0; i < count; i++) {
+        fetch_lump(lumps[i]);
+    }
+}
+
+/**
+ * Helper: Fetch every frame of the sprite a thing type spawns with (THINGS).
+ */
+static void fetch_thing(int doomednum) {
+    for (int type = 0; type < NUMMOBJTYPES; type++) {
+        if (mobjinfo[type].doomednum != doomednum) {
+            continue;
+        }
+        const spritedef_t* sprite = &sprites[states[mobjinfo[type].spawnstate].sprite];
+        for (int frame = 0; frame < sprite->numframes; frame++) {
+            for (int rot = 0; rot < 8; rot++) {
+                int lump = sprite->spriteframes[frame].lump[rot];
+                if (lump >= 0) {
+                    fetch_lump(firstspritelump + lump);
+                }
+            }
+        }
+        return;
+    }
+}
+
+static void* prefetch_worker(void* arg) {
+    (void)arg;
+    uint64_t start_us = doom_clock_us();
+
+    /* Disk reads must not compete with the game loop on its CPU or at its
+     * real-time priority: back to the process's own placement */
+    doom_sched_apply(SCHED_ROLE_IO, 0);
+
+    /* Map lumps, in the order P_SetupLevel() loads them */
+    for (int i = 1; i <= MAP_LUMPS; i++) {
+        fetch_lump(g_map_lump + i);
+    }
+
+    /* Graphics working set from the raw map data (precache only) */
+    int sectors = g_map_lump + ML_SECTORS;
+    int sides = g_map_lump + ML_SIDEDEFS;
+    int things = g_map_lump + ML_THINGS;
+    if (g_graphics && g_state[sectors] == LUMP_READY &&
+        g_state[sides] == LUMP_READY && g_state[things] == LUMP_READY) {
+        const mapsector_t* ms = g_data[sectors];
+        for (int i = 0; i < lumpinfo[sectors].size / (int)sizeof(mapsector_t); i++) {
+            fetch_flat(ms[i].floorpic);
+            fetch_flat(ms[i].ceilingpic);
+        }
+
+        const mapsidedef_t* msd = g_data[sides];
+        for (int i = 0; i < lumpinfo[sides].size / (int)sizeof(mapsidedef_t); i++) {
+            fetch_texture(msd[i].toptexture);
+            fetch_texture(msd[i].midtexture);
+            fetch_texture(msd[i].bottomtexture);
+        }
+
+        const mapthing_t* mt = g_data[things];
+        for (int i = 0; i < lumpinfo[things].size / (int)sizeof(mapthing_t); i++) {
+            fetch_thing(SHORT(mt[i].type));
+        }
+    }
+
+    g_fetch_us = doom_clock_us() - start_us;
+    return NULL;
+}
+
+/**
+ * Helper: Wait for the worker (if running).
+ */
+static void join_worker(void) {
+    if (g_active) {
+        pthread_join(g_thread, NULL);
+        g_active = 0;
+    }
+}
+
+static void prefetch_shutdown(void) {
+    __atomic_store_n(&g_stop, 1, __ATOMIC_RELAXED);
+    join_worker();
+}
+
+void doom_prefetch_install(void) {
+    kidoom_prefetch_addfile = prefetch_addfile;
+    kidoom_prefetch_read = prefetch_read;
+}
+
+void doom_prefetch_next_level(void) {
+    if (g_started) {
+        return;
+    }
+    g_started = 1;
+    if (M_CheckParm("-noprefetch")) {
+        return;
+    }
+
+    /* Same naming as G_DoLoadLevel() */
+    int map = wminfo.next + 1;
+    if (gamemode == commercial) {
+        snprintf(g_map_name, sizeof(g_map_name), "MAP%02d", map);
+    } else {
+        snprintf(g_map_name, sizeof(g_map_name), "E%dM%d", gameepisode, map);
+    }
+    int map_lump = W_CheckNumForName(g_map_name);
+    if (map_lump < 0 || (unsigned int)map_lump + MAP_LUMPS >= numlumps) {
+        return;  /* End of the episode */
+    }
+
+    if (g_state == NULL) {
+        g_state = calloc(numlumps, sizeof(*g_state));
+        g_data = calloc(numlumps, sizeof(*g_data));
+        if (g_state == NULL || g_data == NULL) {
+            free(g_state);
+            free(g_data);
+            g_state = NULL;
+            g_data = NULL;
+            return;
+        }
+        I_AtExit(prefetch_shutdown, true);
+    }
+
+    /* R_PrecacheLevel() only runs with precache on (off in vector-only runs) */
+    g_map_lump = map_lump;
+    g_graphics = precache;
+    g_fetched = 0;
+    g_fetched_bytes = 0;
+    g_served = 0;
+
+    if (pthread_create(&g_thread, NULL, prefetch_worker, NULL) != 0) {
+        fprintf(stderr, "doom_prefetch_next_level: failed to start worker\n");
+        g_map_lump = -1;
+        return;
+    }
+    g_active = 1;
+}
+
+void doom_prefetch_finish(void) {
+    g_started = 0;  /* Ready for the next intermission */
+    if (g_map_lump < 0) {
+        return;
+    }
+    join_worker();
+
+    printf("✓ Prefetched %s: %d lumps (%zu KB) in %.1f ms, %d read from memory\n",
+           g_map_name, g_fetched, g_fetched_bytes / 1024, g_fetch_us / 1000.0, g_served);
+
+    for (unsigned int i = 0; i < numlumps; i++) {
+        free(g_data[i]);
+        g_data[i] = NULL;
+    }
+    memset(g_state, LUMP_NONE, numlumps);
+    g_map_lump = -1;
+}
+
+#else
+
+void doom_prefetch_install(void) {
+}
+
+void doom_prefetch_next_level(void) {
+}
+
+void doom_prefetch_finish(void) {
+}
+
+#endif /* KIDOOM_LEVEL_PREFETCH */
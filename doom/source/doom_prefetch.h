@@ -0,0 +1,48 @@
+/**
+ * doom_prefetch.h
+ *
+ * Background prefetch of the next level during the intermission.
+ *
+ * A level transition runs P_SetupLevel() on the game thread: it reads the
+ * map lumps and, unless precaching is off, every texture patch, flat and
+ * sprite the level uses, all synchronously - the board freezes for several
+ * frames. The next map is known as soon as the intermission starts
+ * (wminfo.next), so with patches/level_prefetch.patch a worker thread reads
+ * those lumps while the intermission runs: the map lumps first, then the
+ * graphics working set found by parsing the raw SIDEDEFS, SECTORS and
+ * THINGS (textures, flats and spawn sprites, the same set R_PrecacheLevel()
+ * loads). W_ReadLump() then copies them from memory instead of the WAD.
+ *
+ * Building the level structures stays on the game thread: it allocates from
+ * the zone, which isn't thread-safe. The worker uses its own file handles
+ * and only reads tables that are fixed after startup.
+ *
+ * Option: -noprefetch.
+ */
+
+#ifndef DOOM_PREFETCH_H
+#define DOOM_PREFETCH_H
+
+#define PREFETCH_MAX_BYTES  (16 * 1024 * 1024)  /* Per level */
+#define PREFETCH_MAX_WADS   32
+#define PREFETCH_MAX_PATCHES 64                 /* Per texture */
+
+/**
+ * Install the w_wad.c hooks. Must run before doomgeneric_Create() (the WADs
+ * are added inside it). No-op unless built with -DKIDOOM_LEVEL_PREFETCH.
+ */
+void doom_prefetch_install(void);
+
+/**
+ * Start prefetching the level the intermission leads to. Call every frame
+ * during GS_INTERMISSION; only the first call per intermission starts work.
+ */
+void doom_prefetch_next_level(void);
+
+/**
+ * The level is set up: wait for the worker, print what the prefetch did
+ * and release the buffers.
+ */
+void doom_prefetch_finish(void);
+
+#endif /* DOOM_PREFETCH_H */
@@ -0,0 +1,359 @@
+/**
+ * doom_raster.c
+ *
+ * Deferred column/span drawing split into vertical strips.
+ *
+ * The recording functions replace colfunc/spanfunc and copy the dc_* / ds_*
+ * globals into a command queue. A flush hands every strip to a worker (the
+ * main thread takes strip 0) and waits for all of them: each worker walks
+ * the whole queue in order but only touches pixels in its own column range,
+ * so overdraw order - and fuzz reading the pixels above and below - is the
+ * same as when DOOM draws serially.
+ */
+
+#include "doom_raster.h"
+#include "doom_clock.h"
+#include "doom_sched.h"
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "doomdef.h"
+#include "i_system.h"
+#include "r_draw.h"
+#include "r_main.h"
+#include "r_state.h"
+
+#ifdef KIDOOM_RASTER_HOOKS
+
+/* Same table size as r_draw.c */
+#define RASTER_FUZZTABLE 50
+
+#define RASTER_COLUMN     0
+#define RASTER_FUZZ       1
+#define RASTER_TRANSLATED 2
+#define RASTER_SPAN       3
+
+typedef struct {
+    int kind;
+    int x1, x2;          /* Column: x1 == x2 == dc_x. Span: ds_x1..ds_x2 */
+    int y1, y2;          /* Column: dc_yl..dc_yh. Span: y1 == y2 == ds_y */
+    unsigned int frac;   /* Column: texture row at y1. Span: packed xy position at x1 */
+    unsigned int step;   /* Column: dc_iscale. Span: packed xy step */
+    int fuzzpos;         /* Fuzz: fuzzpos at y1 */
+    const byte* source;
+    const lighttable_t* colormap;
+    const byte* translation;
+} raster_cmd_t;
+
+typedef struct {
+    pthread_t thread;
+    int index;
+} raster_worker_t;
+
+/* Declare external DOOM variables (defined in r_draw.c / r_main.c, or by
+ * patches/raster_hooks.patch) */
+extern int fuzzoffset[RASTER_FUZZTABLE];
+extern int fuzzpos;
+extern void (*kidoom_raster_begin)(void);
+extern void (*kidoom_raster_flush)(void);
+
+static raster_cmd_t g_cmds[RASTER_MAX_COMMANDS];
+static int g_cmd_count = 0;
+
+static int g_thread_count = 0;
+static raster_worker_t g_workers[RASTER_MAX_THREADS];
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_done = PTHREAD_COND_INITIALIZER;
+static unsigned int g_generation = 0;  /* Bumped once per flush */
+static int g_busy = 0;                 /* Workers still drawing this flush */
+static int g_stopping = 0;
+
+static uint64_t g_flushes = 0;
+static uint64_t g_flush_us = 0;
+static uint64_t g_commands = 0;
+
+/**
+ * Helper: Draw the part of a column or span that lies in [sx1, sx2].
+ * Same inner loops as R_DrawColumn / R_DrawFuzzColumn /
+ * R_DrawTranslatedColumn / R_DrawSpan.
+ */
+static void draw_cmd(const raster_cmd_t* c, int sx1, int sx2) {
+    if (c->kind == RASTER_SPAN) {
+        int x1 = c->x1 < sx1 ? sx1 : c->x1;
+        int x2 = c->x2 > sx2 ? sx2 : c->x2;
+        if (x1 > x2) {
+            return;
+        }
+
+        /* Packed position advances with wraparound, so skipping ahead by
+         * k pixels is exactly k additions */
+        unsigned int position = c->frac + (unsigned int)(x1 - c->x1) * c->step;
+        byte* dest = ylookup[c->y1] + columnofs[x1];
+        int count = x2 - x1;
+        do {
+            unsigned int ytemp = (position >> 4) & 0x0fc0;
+            unsigned int xtemp = position >> 26;
+            *dest++ = c->colormap[c->source[xtemp | ytemp]];
+            position += c->step;
+        } while (count--);
+        return;
+    }
+
+    if (c->x1 < sx1 || c->x1 > sx2) {
+        return;
+    }
+
+    byte* dest = ylookup[c->y1] + columnofs[c->x1];
+    int count = c->y2 - c->y1;
+    fixed_t frac = (fixed_t)c->frac;
+    fixed_t fracstep = (fixed_t)c->step;
+
+    switch (c->kind) {
+        case RASTER_COLUMN:
+            do {
+                *dest = c->colormap[c->source[(frac >> FRACBITS) & 127]];
+                dest += SCREENWIDTH;
+                frac += fracstep;
+            } while (count--);
+            break;
+
+        case RASTER_TRANSLATED:
+            do {
+                *dest = c->colormap[c->translation[c->source[frac >> FRACBITS]]];
+                dest += SCREENWIDTH;
+                frac += fracstep;
+            } while (count--);
+            break;
+
+        case RASTER_FUZZ: {
+            int pos = c->fuzzpos;
+            do {
+                *dest = colormaps[6 * 256 + dest[fuzzoffset[pos]]];
+                if (++pos == RASTER_FUZZTABLE) pos = 0;
+                dest += SCREENWIDTH;
+            } while (count--);
+            break;
+        }
+    }
+}
+
+/**
+ * Helper: Replay the whole queue for one strip.
+ */
+static void draw_strip(int index) {
+    int sx1 = viewwidth * index / g_thread_count;
+    int sx2 = viewwidth * (index + 1) / g_thread_count - 1;
+
+    for (int i = 0; i < g_cmd_count; i++) {
+        draw_cmd(&g_cmds[i], sx1, sx2);
+    }
+}
+
+static void* raster_worker(void* arg) {
+    raster_worker_t* worker = (raster_worker_t*)arg;
+    unsigned int seen = 0;
+
+    /* Strip 0 is the main thread's, so workers start at the first raster CPU */
+    doom_sched_apply(SCHED_ROLE_RASTER, worker->index - 1);
+
+    for (;;) {
+        pthread_mutex_lock(&g_lock);
+        while (g_generation == seen && !g_stopping) {
+            pthread_cond_wait(&g_start, &g_lock);
+        }
+        if (g_stopping) {
+            pthread_mutex_unlock(&g_lock);
+            return NULL;
+        }
+        seen = g_generation;
+        pthread_mutex_unlock(&g_lock);
+
+        draw_strip(worker->index);
+
+        pthread_mutex_lock(&g_lock);
+        if (--g_busy == 0) {
+            pthread_cond_signal(&g_done);
+        }
+        pthread_mutex_unlock(&g_lock);
+    }
+}
+
+/**
+ * Draw everything queued so far on all strips and wait for the join.
+ * Installed as kidoom_raster_flush; also runs before the zone purges a
+ * cache block a queued draw might still read from.
+ */
+static void raster_flush(void) {
+    if (g_cmd_count == 0) {
+        return;
+    }
+
+    uint64_t start_us = doom_clock_us();
+
+    pthread_mutex_lock(&g_lock);
+    g_busy = g_thread_count - 1;
+    g_generation++;
+    pthread_cond_broadcast(&g_start);
+    pthread_mutex_unlock(&g_lock);
+
+    draw_strip(0);
+
+    pthread_mutex_lock(&g_lock);
+    while (g_busy > 0) {
+        pthread_cond_wait(&g_done, &g_lock);
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    g_commands += g_cmd_count;
+    g_cmd_count = 0;
+    g_flushes++;
+    g_flush_us += doom_clock_us() - start_us;
+}
+
+/**
+ * Helper: Next free queue slot, flushing first if the queue is full.
+ */
+static raster_cmd_t* next_cmd(int kind) {
+    if (g_cmd_count >= RASTER_MAX_COMMANDS) {
+        raster_flush();
+    }
+    raster_cmd_t* c = &g_cmds[g_cmd_count++];
+    c->kind = kind;
+    return c;
+}
+
+/**
+ * Helper: Queue a column using the current dc_* state.
+ */
+static void record_column(int kind) {
+    int yl = dc_yl;
+    int yh = dc_yh;
+
+    if (kind == RASTER_FUZZ) {
+        /* Fuzz reads the rows above and below - keep off the view edges */
+        if (yl == 0) yl = 1;
+        if (yh == viewheight - 1) yh = viewheight - 2;
+    }
+
+    if (yh < yl) {
+        return;
+    }
+
+    raster_cmd_t* c = next_cmd(kind);
+    c->x1 = c->x2 = dc_x;
+    c->y1 = yl;
+    c->y2 = yh;
+    c->frac = (unsigned int)(dc_texturemid + (yl - centery) * dc_iscale);
+    c->step = (unsigned int)dc_iscale;
+    c->source = dc_source;
+    c->colormap = dc_colormap;
+    c->translation = dc_translation;
+
+    if (kind == RASTER_FUZZ) {
+        /* Advance DOOM's fuzz position as if the column had been drawn */
+        c->fuzzpos = fuzzpos;
+        fuzzpos = (fuzzpos + (yh - yl + 1)) % RASTER_FUZZTABLE;
+    }
+}
+
+static void raster_column(void) {
+    record_column(RASTER_COLUMN);
+}
+
+static void raster_fuzz_column(void) {
+    record_column(RASTER_FUZZ);
+}
+
+static void raster_translated_column(void) {
+    record_column(RASTER_TRANSLATED);
+}
+
+static void raster_span(void) {
+    if (ds_x2 < ds_x1) {
+        return;
+    }
+
+    raster_cmd_t* c = next_cmd(RASTER_SPAN);
+    c->x1 = ds_x1;
+    c->x2 = ds_x2;
+    c->y1 = c->y2 = ds_y;
+    c->frac = ((ds_xfrac << 10) & 0xffff0000) | ((ds_yfrac >> 6) & 0x0000ffff);
+    c->step = ((ds_xstep << 10) & 0xffff0000) | ((ds_ystep >> 6) & 0x0000ffff);
+    c->source = ds_source;
+    c->colormap = ds_colormap;
+}
+
+/**
+ * Install the recording functions for this frame. R_ExecuteSetViewSize()
+ * resets the function pointers, so this runs at the start of every view.
+ */
+static void raster_begin(void) {
+    if (detailshift != 0) {
+        return;  /* Low detail: the *Low draw functions stay in charge */
+    }
+
+    colfunc = basecolfunc = raster_column;
+    fuzzcolfunc = raster_fuzz_column;
+    transcolfunc = raster_translated_column;
+    spanfunc = raster_span;
+}
+
+static void raster_stop(void) {
+    pthread_mutex_lock(&g_lock);
+    g_stopping = 1;
+    pthread_cond_broadcast(&g_start);
+    pthread_mutex_unlock(&g_lock);
+
+    for (int i = 1; i < g_thread_count; i++) {
+        pthread_join(g_workers[i].thread, NULL);
+    }
+
+    if (g_flushes > 0) {
+        printf("Raster: %d strips, %.0f us/flush, %.0f draws/flush\n",
+               g_thread_count,
+               (double)g_flush_us / g_flushes,
+               (double)g_commands / g_flushes);
+    }
+    g_thread_count = 1;  /* Any later flush draws the full width serially */
+}
+
+int doom_raster_start(int threads) {
+    if (threads < 2) {
+        return -1;
+    }
+    if (threads > RASTER_MAX_THREADS) {
+        threads = RASTER_MAX_THREADS;
+    }
+
+    g_thread_count = threads;
+    for (int i = 1; i < threads; i++) {
+        g_workers[i].index = i;
+        if (pthread_create(&g_workers[i].thread, NULL, raster_worker, &g_workers[i]) != 0) {
+            fprintf(stderr, "doom_raster_start: failed to start worker %d\n", i);
+            g_thread_count = i;
+            raster_stop();
+            return -1;
+        }
+    }
+
+    kidoom_raster_begin = raster_begin;
+    kidoom_raster_flush = raster_flush;
+    I_AtExit(raster_stop, true);
+
+    printf("✓ Strip rasterizer: %d threads\n", threads);
+    return 0;
+}
+
+#else
+
+int doom_raster_start(int threads) {
+    (void)threads;
+    fprintf(stderr, "Warning: -rasterthreads requires patches/raster_hooks.patch "
+                    "and -DKIDOOM_RASTER_HOOKS\n");
+    return -1;
+}
+
+#endif /* KIDOOM_RASTER_HOOKS */
@@ -0,0 +1,35 @@
+/**
+ * doom_raster.h
+ *
+ * Multithreaded strip rasterizer for the SDL framebuffer path.
+ *
+ * DOOM draws the 3D view one column or span at a time while it walks the
+ * BSP, so the pixel work is interleaved with traversal and can't simply be
+ * run on several cores. With patches/raster_hooks.patch applied, the wall,
+ * sky, visplane and masked sprite draws are queued instead (every parameter
+ * the draw needs is captured at queue time, clipping included). At the end
+ * of R_RenderPlayerView() the view is split into vertical strips and each
+ * strip replays the queue in original order on its own thread, drawing only
+ * the pixels inside it. Output is pixel-identical to the serial renderer.
+ *
+ * Low-detail mode (detailshift) keeps drawing directly.
+ */
+
+#ifndef DOOM_RASTER_H
+#define DOOM_RASTER_H
+
+#define RASTER_MAX_THREADS   8
+#define RASTER_MAX_COMMANDS  16384  /* Queue flushes early when full */
+
+/**
+ * Start the strip workers and install the render hooks. Registers an exit
+ * handler that stops the workers and prints the average flush time.
+ *
+ * Args:
+ *   threads: Strip count including the main thread (2..RASTER_MAX_THREADS)
+ *
+ * Returns: 0 on success, -1 on error (engine draws serially)
+ */
+int doom_raster_start(int threads);
+
+#endif /* DOOM_RASTER_H */
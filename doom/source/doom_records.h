@@ -0,0 +1,116 @@
+/**
+ * doom_records.h
+ *
+ * GENERATED by gen_records.py from frame_records.schema - do not edit.
+ *
+ * Binary frame record packers. Offsets and sizes are compile-time
+ * constants; values are stored packed and little-endian.
+ */
+
+#ifndef DOOM_RECORDS_H
+#define DOOM_RECORDS_H
+
+#include <stdint.h>
+
+#include "doom_frame.h"
+
+/* Hash of frame_records.schema, sent by the consumer in INIT_COMPLETE */
+#define RECORDS_SCHEMA_HASH 0x3fe90c0702777f70ULL
+
+static inline void records_put_8(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+}
+
+static inline void records_put_16(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void records_put_32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* frame (doom_frame_t) */
+#define RECORD_FRAME_SIZE 12
+#define RECORD_FRAME_FRAME 0
+#define RECORD_FRAME_TIC 4
+#define RECORD_FRAME_WALL_COUNT 8
+#define RECORD_FRAME_ENTITY_COUNT 10
+
+/**
+ * Pack one frame record at out.
+ *
+ * Returns: out + RECORD_FRAME_SIZE
+ */
+static inline uint8_t* doom_records_pack_frame(uint8_t* out, const doom_frame_t* r) {
+    records_put_32(out + RECORD_FRAME_FRAME, (uint32_t)r->frame);
+    records_put_32(out + RECORD_FRAME_TIC, (uint32_t)r->tic);
+    records_put_16(out + RECORD_FRAME_WALL_COUNT, (uint32_t)r->wall_count);
+    records_put_16(out + RECORD_FRAME_ENTITY_COUNT, (uint32_t)r->sprite_count);
+    return out + RECORD_FRAME_SIZE;
+}
+
+/* wall (wall_record_t) */
+#define RECORD_WALL_SIZE 27
+#define RECORD_WALL_X1 0
+#define RECORD_WALL_Y1_TOP 4
+#define RECORD_WALL_Y1_BOTTOM 8
+#define RECORD_WALL_X2 12
+#define RECORD_WALL_Y2_TOP 16
+#define RECORD_WALL_Y2_BOTTOM 20
+#define RECORD_WALL_DISTANCE 24
+#define RECORD_WALL_SILHOUETTE 26
+
+/**
+ * Pack one wall record at out.
+ *
+ * Returns: out + RECORD_WALL_SIZE
+ */
+static inline uint8_t* doom_records_pack_wall(uint8_t* out, const wall_record_t* r) {
+    records_put_32(out + RECORD_WALL_X1, (uint32_t)r->x1);
+    records_put_32(out + RECORD_WALL_Y1_TOP, (uint32_t)r->y1_top);
+    records_put_32(out + RECORD_WALL_Y1_BOTTOM, (uint32_t)r->y1_bottom);
+    records_put_32(out + RECORD_WALL_X2, (uint32_t)r->x2);
+    records_put_32(out + RECORD_WALL_Y2_TOP, (uint32_t)r->y2_top);
+    records_put_32(out + RECORD_WALL_Y2_BOTTOM, (uint32_t)r->y2_bottom);
+    records_put_16(out + RECORD_WALL_DISTANCE, (uint32_t)r->distance);
+    records_put_8(out + RECORD_WALL_SILHOUETTE, (uint32_t)r->silhouette);
+    return out + RECORD_WALL_SIZE;
+}
+
+/* entity (sprite_record_t) */
+#define RECORD_ENTITY_SIZE 37
+#define RECORD_ENTITY_X 0
+#define RECORD_ENTITY_Y_TOP 4
+#define RECORD_ENTITY_Y_BOTTOM 8
+#define RECORD_ENTITY_HEIGHT 12
+#define RECORD_ENTITY_TYPE 16
+#define RECORD_ENTITY_DISTANCE 18
+#define RECORD_ENTITY_ID 20
+#define RECORD_ENTITY_HAS_PREV 24
+#define RECORD_ENTITY_PREV 25
+
+/**
+ * Pack one entity record at out.
+ *
+ * Returns: out + RECORD_ENTITY_SIZE
+ */
+static inline uint8_t* doom_records_pack_entity(uint8_t* out, const sprite_record_t* r) {
+    records_put_32(out + RECORD_ENTITY_X, (uint32_t)r->x);
+    records_put_32(out + RECORD_ENTITY_Y_TOP, (uint32_t)r->y_top);
+    records_put_32(out + RECORD_ENTITY_Y_BOTTOM, (uint32_t)r->y_bottom);
+    records_put_32(out + RECORD_ENTITY_HEIGHT, (uint32_t)r->height);
+    records_put_16(out + RECORD_ENTITY_TYPE, (uint32_t)r->type);
+    records_put_16(out + RECORD_ENTITY_DISTANCE, (uint32_t)r->distance);
+    records_put_32(out + RECORD_ENTITY_ID, (uint32_t)r->id);
+    records_put_8(out + RECORD_ENTITY_HAS_PREV, (uint32_t)r->has_prev);
+    records_put_32(out + RECORD_ENTITY_PREV + 0, (uint32_t)r->prev[0]);
+    records_put_32(out + RECORD_ENTITY_PREV + 4, (uint32_t)r->prev[1]);
+    records_put_32(out + RECORD_ENTITY_PREV + 8, (uint32_t)r->prev[2]);
+    return out + RECORD_ENTITY_SIZE;
+}
+
+#endif /* DOOM_RECORDS_H */
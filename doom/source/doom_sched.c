@@ -0,0 +1,257 @@
+/**
+ * doom_sched.c
+ *
+ * Thread placement and scheduling latency statistics.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE  /* CPU_SET, pthread_setaffinity_np */
+#endif
+
+#include "doom_sched.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+typedef struct {
+    int cpus[SCHED_MAX_CPUS];
+    int cpu_count;
+    int policy;
+    int priority;
+} sched_role_t;
+
+static const char* g_role_names[SCHED_ROLE_COUNT] = { "game", "export", "raster", "io" };
+
+static sched_role_t g_roles[SCHED_ROLE_COUNT];
+
+/* The process's own placement, saved before any thread is pinned: threads
+ * inherit their creator's, so roles without settings are reset to this */
+static int g_have_defaults = 0;
+#ifdef __linux__
+static cpu_set_t g_default_cpus;
+static int g_have_default_cpus = 0;
+#endif
+static int g_default_policy = SCHED_OTHER;
+static struct sched_param g_default_param;
+static sched_latency_t g_latency[SCHED_ROLE_COUNT];
+static pthread_mutex_t g_latency_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Helper: Parse "4-7,10" into a CPU list.
+ */
+static int parse_cpus(const char* list, int* cpus, int max) {
+    int count = 0;
+    const char* p = list;
+
+    while (*p != '\0') {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0) {
+            return -1;
+        }
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first) {
+                return -1;
+            }
+        }
+        for (long cpu = first; cpu <= last && count < max; cpu++) {
+            cpus[count++] = (int)cpu;
+        }
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return -1;
+        }
+        p = end;
+    }
+
+    return count;
+}
+
+/**
+ * Helper: Save the calling thread's affinity and policy as the defaults.
+ */
+static void save_defaults(void) {
+    if (g_have_defaults) {
+        return;
+    }
+    g_have_defaults = 1;
+
+#ifdef __linux__
+    g_have_default_cpus = sched_getaffinity(0, sizeof(g_default_cpus), &g_default_cpus) == 0;
+#endif
+    if (pthread_getschedparam(pthread_self(), &g_default_policy, &g_default_param) != 0) {
+        g_default_policy = SCHED_OTHER;
+        memset(&g_default_param, 0, sizeof(g_default_param));
+    }
+}
+
+int doom_sched_configure(int role, const char* cpus, int policy, int priority) {
+    sched_role_t* r = &g_roles[role];
+
+    save_defaults();
+
+    r->cpu_count = 0;
+    if (cpus != NULL) {
+        r->cpu_count = parse_cpus(cpus, r->cpus, SCHED_MAX_CPUS);
+        if (r->cpu_count < 0) {
+            fprintf(stderr, "ERROR: Invalid CPU list for %s threads: %s\n", g_role_names[role], cpus);
+            r->cpu_count = 0;
+            return -1;
+        }
+    }
+
+    r->policy = policy;
+    r->priority = priority;
+    return 0;
+}
+
+/**
+ * Helper: Pin the calling thread to one CPU.
+ */
+static void pin_thread(int role, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        fprintf(stderr, "Warning: Cannot pin %s thread to CPU %d: %s\n",
+                g_role_names[role], cpu, strerror(err));
+    } else {
+        printf("✓ %s thread pinned to CPU %d\n", g_role_names[role], cpu);
+    }
+#else
+    (void)cpu;
+    fprintf(stderr, "Warning: CPU pinning not supported on this platform (%s thread)\n",
+            g_role_names[role]);
+#endif
+}
+
+/**
+ * Helper: Switch the calling thread to a real-time policy.
+ */
+static void set_realtime(int role, int policy, int priority) {
+    int sys_policy = (policy == SCHED_POLICY_RR) ? SCHED_RR : SCHED_FIFO;
+
+    int lo = sched_get_priority_min(sys_policy);
+    int hi = sched_get_priority_max(sys_policy);
+    if (hi > SCHED_RT_PRIORITY_MAX) hi = SCHED_RT_PRIORITY_MAX;
+    if (priority < lo) priority = lo;
+    if (priority > hi) priority = hi;
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+
+    int err = pthread_setschedparam(pthread_self(), sys_policy, &param);
+    if (err != 0) {
+        fprintf(stderr, "Warning: Cannot set %s for %s thread: %s\n",
+                policy == SCHED_POLICY_RR ? "SCHED_RR" : "SCHED_FIFO",
+                g_role_names[role], strerror(err));
+    } else {
+        printf("✓ %s thread: %s priority %d\n", g_role_names[role],
+               policy == SCHED_POLICY_RR ? "SCHED_RR" : "SCHED_FIFO", priority);
+    }
+}
+
+/**
+ * Helper: Give the calling thread the process's original CPU mask back.
+ */
+static void reset_affinity(int role) {
+#ifdef __linux__
+    if (!g_have_default_cpus) {
+        return;
+    }
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(g_default_cpus), &g_default_cpus);
+    if (err != 0) {
+        fprintf(stderr, "Warning: Cannot reset CPU affinity of %s thread: %s\n",
+                g_role_names[role], strerror(err));
+    }
+#else
+    (void)role;
+#endif
+}
+
+/**
+ * Helper: Give the calling thread the process's original policy back
+ * (SCHED_OTHER unless DOOM was started under chrt).
+ */
+static void reset_policy(int role) {
+    if (!g_have_defaults) {
+        return;
+    }
+    int err = pthread_setschedparam(pthread_self(), g_default_policy, &g_default_param);
+    if (err != 0) {
+        fprintf(stderr, "Warning: Cannot reset scheduling policy of %s thread: %s\n",
+                g_role_names[role], strerror(err));
+    }
+}
+
+void doom_sched_apply(int role, int index) {
+    sched_role_t* r = &g_roles[role];
+
+    /* Without settings, undo what was inherited from a pinned/RT creator */
+    if (r->cpu_count > 0) {
+        pin_thread(role, r->cpus[index % r->cpu_count]);
+    } else {
+        reset_affinity(role);
+    }
+    if (r->policy != SCHED_POLICY_NORMAL) {
+        set_realtime(role, r->policy, r->priority);
+    } else {
+        reset_policy(role);
+    }
+}
+
+int doom_sched_lock_memory(void) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        fprintf(stderr, "Warning: mlockall failed: %s\n", strerror(errno));
+        return -1;
+    }
+    printf("✓ Memory locked (mlockall)\n");
+    return 0;
+}
+
+void doom_sched_record_latency(int role, uint64_t latency_us) {
+    pthread_mutex_lock(&g_latency_lock);
+    sched_latency_t* l = &g_latency[role];
+    l->count++;
+    l->total_us += latency_us;
+    if (latency_us > l->max_us) {
+        l->max_us = latency_us;
+    }
+    pthread_mutex_unlock(&g_latency_lock);
+}
+
+void doom_sched_get_latency(int role, sched_latency_t* out) {
+    pthread_mutex_lock(&g_latency_lock);
+    *out = g_latency[role];
+    pthread_mutex_unlock(&g_latency_lock);
+}
+
+void doom_sched_report(void) {
+    const char* sep = "";
+
+    printf("Wake latency:");
+    for (int role = 0; role < SCHED_ROLE_COUNT; role++) {
+        sched_latency_t l;
+        doom_sched_get_latency(role, &l);
+        if (l.count == 0) {
+            continue;
+        }
+        printf("%s %s avg %llu us max %llu us", sep, g_role_names[role],
+               (unsigned long long)(l.total_us / l.count), (unsigned long long)l.max_us);
+        sep = " |";
+    }
+    printf("\n");
+}
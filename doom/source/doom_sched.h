@@ -0,0 +1,96 @@
+/**
+ * doom_sched.h
+ *
+ * CPU affinity, real-time scheduling and memory locking for DOOM's threads.
+ *
+ * On a busy workstation the game loop gets descheduled behind KiCad's UI
+ * thread and frame times spike. Each thread role can be pinned to chosen
+ * cores and run under SCHED_FIFO / SCHED_RR at a bounded priority, and all
+ * memory can be locked to avoid page faults. Wake-up latency (how late a
+ * thread runs after it should have) is tracked per role so the effect of
+ * these settings is visible in the stats output.
+ *
+ * Affinity is Linux-only; real-time policies and mlockall() depend on the
+ * process having the necessary privileges (CAP_SYS_NICE / RLIMIT_RTPRIO,
+ * RLIMIT_MEMLOCK). Failures are reported and otherwise ignored.
+ */
+
+#ifndef DOOM_SCHED_H
+#define DOOM_SCHED_H
+
+#include <stdint.h>
+
+/* Thread roles */
+#define SCHED_ROLE_GAME   0  /* Main thread: game loop, extraction, socket I/O */
+#define SCHED_ROLE_EXPORT 1  /* Export sink workers */
+#define SCHED_ROLE_RASTER 2  /* Strip rasterizer workers (-rasterthreads) */
+#define SCHED_ROLE_IO     3  /* Level prefetch reader; never pinned or real-time */
+#define SCHED_ROLE_COUNT  4
+
+#define SCHED_MAX_CPUS 64
+
+/* Real-time priority ceiling - stays below the kernel's threaded IRQ
+ * handlers (priority 50) so DOOM can't starve interrupt processing */
+#define SCHED_RT_PRIORITY_MAX 49
+
+/* Real-time policies */
+#define SCHED_POLICY_NORMAL 0
+#define SCHED_POLICY_FIFO   1
+#define SCHED_POLICY_RR     2
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_us;
+    uint64_t max_us;
+} sched_latency_t;
+
+/**
+ * Configure a thread role. Takes effect when a thread of that role calls
+ * doom_sched_apply().
+ *
+ * Args:
+ *   role: SCHED_ROLE_*
+ *   cpus: Comma/range list like "2" or "4-7,10" (NULL = no pinning)
+ *   policy: SCHED_POLICY_*
+ *   priority: Real-time priority (clamped to the policy range and
+ *             SCHED_RT_PRIORITY_MAX)
+ *
+ * Returns: 0 on success, -1 if the CPU list can't be parsed
+ */
+int doom_sched_configure(int role, const char* cpus, int policy, int priority);
+
+/**
+ * Apply the role's affinity and policy to the calling thread. Threads
+ * inherit both from their creator, so a role without a CPU list gets the
+ * process's original CPU mask back and a role without a real-time policy
+ * its original policy (as saved by the first doom_sched_configure()).
+ *
+ * Args:
+ *   role: SCHED_ROLE_*
+ *   index: Thread index within the role (picks the CPU round-robin)
+ */
+void doom_sched_apply(int role, int index);
+
+/**
+ * Lock all current and future pages in RAM (mlockall).
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int doom_sched_lock_memory(void);
+
+/**
+ * Account one wake-up latency sample for a role. Thread-safe.
+ */
+void doom_sched_record_latency(int role, uint64_t latency_us);
+
+/**
+ * Copy a role's latency statistics.
+ */
+void doom_sched_get_latency(int role, sched_latency_t* out);
+
+/**
+ * Print one line of per-role latency statistics.
+ */
+void doom_sched_report(void);
+
+#endif /* DOOM_SCHED_H */
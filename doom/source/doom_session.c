@@ -0,0 +1,167 @@
+/**
+ * doom_session.c
+ *
+ * Session statistics and the .session.json sidecar for recorded demos.
+ */
+
+#include "doom_session.h"
+#include "doom_clock.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include "doomtype.h"
+#include "i_system.h"
+#include "m_argv.h"
+
+#define SESSION_NAME_MAX 256
+
+static char g_demo_name[SESSION_NAME_MAX];
+static int g_recording = 0;
+static const char* g_mode = "dual";
+
+static time_t g_started_wall;
+static uint64_t g_started_us;
+
+static int g_frames = 0;
+static int g_first_tic = -1;
+static int g_last_tic = -1;
+static uint64_t g_total_bytes = 0;
+static uint64_t g_total_us = 0;
+static uint64_t g_worst_us = 0;
+static int g_worst_tic = -1;
+static uint64_t g_first_frame_us = 0;
+static int g_level_loads = 0;
+static uint64_t g_level_load_us = 0;
+static uint64_t g_level_load_max_us = 0;
+
+/**
+ * Helper: Write a string as a JSON string literal.
+ */
+static void write_json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', f);
+        }
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+/**
+ * Helper: Write <demo>.session.json next to the demo lump.
+ */
+static void write_sidecar(double duration_s) {
+    char path[SESSION_NAME_MAX + 16];
+    snprintf(path, sizeof(path), "%s.session.json", g_demo_name);
+
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Warning: Could not write session metadata %s\n", path);
+        return;
+    }
+
+    char started[32];
+    strftime(started, sizeof(started), "%Y-%m-%dT%H:%M:%S", localtime(&g_started_wall));
+
+    fprintf(f, "{\n  \"demo\": ");
+    write_json_string(f, g_demo_name);
+    fprintf(f, ",\n  \"lump\": \"%s.lmp\",\n", g_demo_name);
+    fprintf(f, "  \"mode\": \"%s\",\n", g_mode);
+    fprintf(f, "  \"started\": \"%s\",\n", started);
+    fprintf(f, "  \"duration_s\": %.3f,\n", duration_s);
+
+    fprintf(f, "  \"args\": [");
+    for (int i = 1; i < myargc; i++) {
+        if (i > 1) fprintf(f, ", ");
+        write_json_string(f, myargv[i]);
+    }
+    fprintf(f, "],\n");
+
+    fprintf(f, "  \"frames\": %d,\n", g_frames);
+    fprintf(f, "  \"first_tic\": %d,\n", g_first_tic);
+    fprintf(f, "  \"last_tic\": %d,\n", g_last_tic);
+    fprintf(f, "  \"bytes\": %llu,\n", (unsigned long long)g_total_bytes);
+    fprintf(f, "  \"frame_us_avg\": %llu,\n",
+            (unsigned long long)(g_frames > 0 ? g_total_us / g_frames : 0));
+    fprintf(f, "  \"frame_us_max\": %llu,\n", (unsigned long long)g_worst_us);
+    fprintf(f, "  \"worst_tic\": %d,\n", g_worst_tic);
+    fprintf(f, "  \"first_frame_ms\": %.1f,\n", g_first_frame_us / 1000.0);
+    fprintf(f, "  \"level_loads\": %d,\n", g_level_loads);
+    fprintf(f, "  \"level_load_ms_max\": %.1f,\n", g_level_load_max_us / 1000.0);
+    fprintf(f, "  \"replay\": \"-headless -timedemo %s\"\n", g_demo_name);
+    fprintf(f, "}\n");
+    fclose(f);
+
+    printf("✓ Session metadata written: %s\n", path);
+}
+
+/**
+ * Exit handler: print the extraction summary and write the sidecar.
+ * Registered with I_AtExit so it also runs when DOOM exits via I_Error
+ * (which is how demo recording and -timedemo finish).
+ */
+static void session_shutdown(void) {
+    double duration_s = (doom_clock_us() - g_started_us) / 1000000.0;
+
+    if (g_frames > 0) {
+        printf("\nSession (%s): %d frames in %.2fs (%.1f FPS), %.1f KB/frame, "
+               "extract avg %llu us, max %llu us (tic %d)\n",
+               g_mode, g_frames, duration_s, g_frames / (duration_s > 0 ? duration_s : 1),
+               g_total_bytes / 1024.0 / g_frames,
+               (unsigned long long)(g_total_us / g_frames),
+               (unsigned long long)g_worst_us, g_worst_tic);
+        printf("Time to first vector frame: %.1f ms\n", g_first_frame_us / 1000.0);
+        if (g_level_loads > 0) {
+            printf("Level loads: %d, avg %.1f ms, max %.1f ms\n", g_level_loads,
+                   g_level_load_us / 1000.0 / g_level_loads, g_level_load_max_us / 1000.0);
+        }
+    }
+
+    if (g_recording) {
+        write_sidecar(duration_s);
+    }
+}
+
+void doom_session_init(const char* demo_name, const char* mode) {
+    g_started_wall = time(NULL);
+    g_started_us = doom_clock_us();
+    g_mode = mode;
+
+    if (demo_name != NULL) {
+        snprintf(g_demo_name, sizeof(g_demo_name), "%s", demo_name);
+        g_recording = 1;
+        printf("✓ Recording demo: %s.lmp (+ .session.json)\n", g_demo_name);
+    }
+
+    I_AtExit(session_shutdown, true);
+}
+
+void doom_session_first_frame(uint64_t startup_us) {
+    g_first_frame_us = startup_us;
+}
+
+void doom_session_frame(int tic, size_t bytes, uint64_t frame_us) {
+    if (g_first_tic < 0) {
+        g_first_tic = tic;
+    }
+    g_last_tic = tic;
+
+    g_frames++;
+    g_total_bytes += bytes;
+    g_total_us += frame_us;
+
+    if (frame_us > g_worst_us) {
+        g_worst_us = frame_us;
+        g_worst_tic = tic;
+    }
+}
+
+void doom_session_level_load(uint64_t load_us) {
+    g_level_loads++;
+    g_level_load_us += load_us;
+    if (load_us > g_level_load_max_us) {
+        g_level_load_max_us = load_us;
+    }
+}
@@ -0,0 +1,59 @@
+/**
+ * doom_session.h
+ *
+ * Session metadata and extraction statistics for recorded runs.
+ *
+ * Input is recorded with DOOM's own demo format (-record <name> writes
+ * <name>.lmp, tic-accurate and replayable with -playdemo / -timedemo). This
+ * module tracks per-frame extraction cost and, when a demo is being recorded,
+ * writes a <name>.session.json sidecar describing the run: command line,
+ * duration, tic range and the slowest frame. Replaying the demo with
+ * -headless -timedemo turns a production stutter into a deterministic
+ * benchmark.
+ */
+
+#ifndef DOOM_SESSION_H
+#define DOOM_SESSION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Start session tracking. Registers an exit handler that prints the
+ * extraction summary and writes the metadata sidecar (if recording).
+ *
+ * Args:
+ *   demo_name: Name passed to -record (without .lmp), or NULL if not recording
+ *   mode: Short description of the output mode (e.g. "dual", "headless")
+ */
+void doom_session_init(const char* demo_name, const char* mode);
+
+/**
+ * Account one extracted frame.
+ *
+ * Args:
+ *   tic: Game tic the frame shows
+ *   bytes: Size of the frame payload
+ *   frame_us: Time spent extracting (and sending) the frame
+ */
+void doom_session_frame(int tic, size_t bytes, uint64_t frame_us);
+
+/**
+ * Record the time from process start to the first gameplay frame that was
+ * extracted (reported in the summary and the sidecar).
+ *
+ * Args:
+ *   startup_us: Microseconds from main() to the first vector frame
+ */
+void doom_session_first_frame(uint64_t startup_us);
+
+/**
+ * Record one level transition stall (summary and sidecar).
+ *
+ * Args:
+ *   load_us: Game time of the first frame of the new level (level setup
+ *            included), in microseconds
+ */
+void doom_session_level_load(uint64_t load_us);
+
+#endif /* DOOM_SESSION_H */
@@ -0,0 +1,259 @@
+/**
+ * doom_skyline.c
+ *
+ * Silhouette ("skyline") extraction from the rendered frame.
+ *
+ * By the time DG_DrawFrame() runs, DOOM has closed every column of
+ * ceilingclip[] / floorclip[] (solid walls set them to viewheight / -1), so
+ * the arrays no longer describe the outline. Instead we replay the same clip
+ * updates over drawsegs[] in BSP (front-to-back) order using local copies of
+ * the arrays, and record the first wall pixel each column receives from the
+ * top and from the bottom.
+ */
+
+#include "doom_skyline.h"
+
+/* Import DOOM's internal rendering structures */
+#include "r_defs.h"
+#include "r_bsp.h"
+#include "r_state.h"
+#include "r_sky.h"
+#include "m_fixed.h"
+
+/* Same sub-pixel precision R_StoreWallRange() uses for wall edges */
+#define HEIGHTBITS 12
+#define HEIGHTUNIT (1 << HEIGHTBITS)
+
+#define COLUMN_UNSET -1
+
+/* Declare external DOOM variables */
+extern drawseg_t drawsegs[MAXDRAWSEGS];
+extern drawseg_t* ds_p;
+
+extern int viewheight;
+extern int viewwidth;
+extern fixed_t centeryfrac;
+extern fixed_t viewz;
+extern int skyflatnum;
+
+/* Replayed clip arrays (same meaning as DOOM's ceilingclip/floorclip) */
+static short g_ceilingclip[SCREENWIDTH];
+static short g_floorclip[SCREENWIDTH];
+
+/* First wall pixel per column, from the top and from the bottom */
+static short g_top[SCREENWIDTH];
+static short g_bottom[SCREENWIDTH];
+
+/**
+ * Helper: Project a world height (relative to viewz) to the first screen row
+ * at or below it, rounding like R_RenderSegLoop() does for wall tops.
+ */
+static int project_top(fixed_t height, fixed_t scale) {
+    fixed_t frac = (centeryfrac >> 4) - FixedMul(height >> 4, scale);
+    return (frac + HEIGHTUNIT - 1) >> HEIGHTBITS;
+}
+
+/**
+ * Helper: Project a world height (relative to viewz) to the last screen row
+ * at or above it, rounding like R_RenderSegLoop() does for wall bottoms.
+ */
+static int project_bottom(fixed_t height, fixed_t scale) {
+    fixed_t frac = (centeryfrac >> 4) - FixedMul(height >> 4, scale);
+    return frac >> HEIGHTBITS;
+}
+
+/**
+ * Helper: Record the top outline of column x if nothing claimed it yet.
+ * y is clamped to the part of the column that is still open.
+ */
+static void mark_top(int x, int y) {
+    if (g_top[x] != COLUMN_UNSET) {
+        return;
+    }
+    if (y <= g_ceilingclip[x]) y = g_ceilingclip[x] + 1;
+    if (y >= g_floorclip[x]) return;  /* Wall fully hidden in this column */
+    g_top[x] = (short)y;
+}
+
+/**
+ * Helper: Record the bottom outline of column x if nothing claimed it yet.
+ */
+static void mark_bottom(int x, int y) {
+    if (g_bottom[x] != COLUMN_UNSET) {
+        return;
+    }
+    if (y >= g_floorclip[x]) y = g_floorclip[x] - 1;
+    if (y <= g_ceilingclip[x]) return;
+    g_bottom[x] = (short)y;
+}
+
+/**
+ * Replay one drawseg against the local clip arrays.
+ */
+static void replay_drawseg(drawseg_t* ds) {
+    seg_t* seg = ds->curline;
+    if (seg == NULL || seg->frontsector == NULL) {
+        return;
+    }
+
+    sector_t* front = seg->frontsector;
+    sector_t* back = seg->backsector;
+
+    int x1 = ds->x1 < 0 ? 0 : ds->x1;
+    int x2 = ds->x2 >= viewwidth ? viewwidth - 1 : ds->x2;
+
+    fixed_t worldtop = front->ceilingheight - viewz;
+    fixed_t worldbottom = front->floorheight - viewz;
+
+    for (int x = x1; x <= x2; x++) {
+        if (g_ceilingclip[x] + 1 >= g_floorclip[x]) {
+            continue;  /* Column already closed by a nearer wall */
+        }
+
+        fixed_t scale = ds->scale1 + (x - ds->x1) * ds->scalestep;
+        int yl = project_top(worldtop, scale);
+        int yh = project_bottom(worldbottom, scale);
+
+        if (back == NULL) {
+            /* Solid wall: everything between the clips is wall */
+            mark_top(x, yl);
+            mark_bottom(x, yh);
+            g_ceilingclip[x] = viewheight;
+            g_floorclip[x] = -1;
+            continue;
+        }
+
+        /* Two-sided line: upper and lower textures narrow the opening */
+        int newceiling = yl - 1;
+        int newfloor = yh + 1;
+
+        int sky = (front->ceilingpic == skyflatnum && back->ceilingpic == skyflatnum);
+        if (!sky && back->ceilingheight < front->ceilingheight) {
+            int mid = project_top(back->ceilingheight - viewz, scale);
+            if (mid > yl) {
+                mark_top(x, yl);
+                newceiling = mid - 1;
+            }
+        }
+
+        if (back->floorheight > front->floorheight) {
+            int mid = project_bottom(back->floorheight - viewz, scale);
+            if (mid < yh) {
+                mark_bottom(x, yh);
+                newfloor = mid + 1;
+            }
+        }
+
+        if (newceiling > g_ceilingclip[x]) g_ceilingclip[x] = (short)newceiling;
+        if (newfloor < g_floorclip[x]) g_floorclip[x] = (short)newfloor;
+    }
+}
+
+int doom_skyline_simplify(const short* ys, int x0, int x1, int tolerance,
+                          short (*out)[2], int max_points) {
+    int count = 0;
+
+    if (max_points <= 0 || x1 < x0) {
+        return 0;
+    }
+
+    int anchor = x0;
+    out[count][0] = (short)anchor;
+    out[count][1] = ys[anchor];
+    count++;
+
+    float lo = -1e9f;
+    float hi = 1e9f;
+
+    for (int x = anchor + 1; x <= x1; x++) {
+        float dx = (float)(x - anchor);
+        float slope = (ys[x] - ys[anchor]) / dx;
+
+        if (slope < lo || slope > hi) {
+            /* x can't be reached in one segment - close it at x-1 */
+            if (count >= max_points) {
+                return count;
+            }
+            anchor = x - 1;
+            out[count][0] = (short)anchor;
+            out[count][1] = ys[anchor];
+            count++;
+
+            lo = -1e9f;
+            hi = 1e9f;
+            dx = 1.0f;
+        }
+
+        float low = (ys[x] - tolerance - ys[anchor]) / dx;
+        float high = (ys[x] + tolerance - ys[anchor]) / dx;
+        if (low > lo) lo = low;
+        if (high < hi) hi = high;
+    }
+
+    if (anchor != x1 && count < max_points) {
+        out[count][0] = (short)x1;
+        out[count][1] = ys[x1];
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Helper: Compress columns [x0, x1] of ys into the polyline as one run.
+ */
+static void simplify_run(const short* ys, int x0, int x1, int tolerance,
+                         skyline_polyline_t* out) {
+    if (out->run_count >= SKYLINE_MAX_RUNS) {
+        return;
+    }
+
+    out->run_start[out->run_count++] = out->point_count;
+    out->point_count += doom_skyline_simplify(ys, x0, x1, tolerance,
+                                              &out->points[out->point_count],
+                                              SKYLINE_MAX_POINTS - out->point_count);
+}
+
+/**
+ * Helper: Split a per-column outline into runs of set columns and compress
+ * each run.
+ */
+static void simplify_outline(const short* ys, int tolerance, skyline_polyline_t* out) {
+    out->point_count = 0;
+    out->run_count = 0;
+
+    int x = 0;
+    while (x < viewwidth) {
+        if (ys[x] == COLUMN_UNSET) {
+            x++;
+            continue;
+        }
+
+        int start = x;
+        while (x + 1 < viewwidth && ys[x + 1] != COLUMN_UNSET) {
+            x++;
+        }
+        simplify_run(ys, start, x, tolerance, out);
+        x++;
+    }
+}
+
+void doom_skyline_build(int tolerance, skyline_polyline_t* top, skyline_polyline_t* bottom) {
+    int ds_count = ds_p - drawsegs;
+
+    if (tolerance < 0) tolerance = 0;
+
+    for (int x = 0; x < viewwidth; x++) {
+        g_ceilingclip[x] = -1;
+        g_floorclip[x] = (short)viewheight;
+        g_top[x] = COLUMN_UNSET;
+        g_bottom[x] = COLUMN_UNSET;
+    }
+
+    for (int i = 0; i < ds_count && i < MAXDRAWSEGS; i++) {
+        replay_drawseg(&drawsegs[i]);
+    }
+
+    simplify_outline(g_top, tolerance, top);
+    simplify_outline(g_bottom, tolerance, bottom);
+}
@@ -0,0 +1,71 @@
+/**
+ * doom_skyline.h
+ *
+ * Run-length silhouette ("skyline") extraction for minimalist consumers.
+ *
+ * Replays DOOM's ceilingclip[] / floorclip[] updates over the frame's
+ * drawsegs to find, for every screen column, the first wall pixel seen from
+ * the top and from the bottom of the view. The two per-column arrays are then
+ * compressed into piecewise-linear polylines that stay within a pixel
+ * tolerance of the original outline.
+ *
+ * Two short polylines per frame replace hundreds of wall quads, which keeps
+ * the oscilloscope beam budget small.
+ */
+
+#ifndef DOOM_SKYLINE_H
+#define DOOM_SKYLINE_H
+
+#include "doomdef.h"
+
+/* Default maximum vertical error (pixels) between polyline and outline */
+#define SKYLINE_DEFAULT_TOLERANCE 2
+
+/* Worst case: every column becomes a vertex, every other column starts a run */
+#define SKYLINE_MAX_POINTS SCREENWIDTH
+#define SKYLINE_MAX_RUNS   (SCREENWIDTH / 2 + 1)
+
+/**
+ * One compressed outline. Vertices are stored as (x, y) screen pairs; a new
+ * run starts wherever the outline has a gap (columns with no wall pixels).
+ */
+typedef struct {
+    int point_count;
+    short points[SKYLINE_MAX_POINTS][2];
+
+    int run_count;
+    int run_start[SKYLINE_MAX_RUNS];  /* Index of first point of each run */
+} skyline_polyline_t;
+
+/**
+ * Build top and bottom outlines for the frame that was just rendered.
+ * Must be called after R_RenderPlayerView() (i.e. from DG_DrawFrame).
+ *
+ * Args:
+ *   tolerance: Maximum vertical deviation in pixels (0 = exact outline)
+ *   top: Output - outline between ceiling/sky and walls
+ *   bottom: Output - outline between walls and floor
+ */
+void doom_skyline_build(int tolerance, skyline_polyline_t* top, skyline_polyline_t* bottom);
+
+/**
+ * Compress one per-column outline into polyline vertices.
+ *
+ * Greedy "sleeve" simplification: from the current anchor, keep extending
+ * while the slope to the candidate endpoint stays inside the slope window
+ * that keeps every skipped column within tolerance. Linear time, and every
+ * vertex is an original (x, ys[x]) sample. Also used for visplane outlines.
+ *
+ * Args:
+ *   ys: Per-column screen rows (indexed by x)
+ *   x0, x1: Inclusive column range to compress
+ *   tolerance: Maximum vertical deviation in pixels
+ *   out: Output - (x, y) vertex pairs
+ *   max_points: Capacity of out
+ *
+ * Returns: Number of vertices written
+ */
+int doom_skyline_simplify(const short* ys, int x0, int x1, int tolerance,
+                          short (*out)[2], int max_points);
+
+#endif /* DOOM_SKYLINE_H */
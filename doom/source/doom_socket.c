@@ -6,10 +6,14 @@
  */
 
 #include "doom_socket.h"
+#include "doom_input.h"
+#include "doom_pacing.h"
+#include "doom_trace.h"
 
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,6 +23,23 @@
 /* Global socket file descriptor */
 static int g_socket_fd = -1;
 
+/* Small control messages waiting to go out with the next frame */
+static char g_pending[SOCKET_PENDING_MAX];
+static size_t g_pending_len = 0;
+
+static socket_stats_t g_stats;
+
+/* Record schema hash announced by the consumer (0 = JSON only) */
+static uint64_t g_peer_schema = 0;
+
+/* Extra viewpoint subscribers (send-only, JSON frames) */
+static int g_view_fds[SOCKET_VIEWS_MAX] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+
+/* Unsent tail of a subscriber's last frame (goes out before the next one) */
+static char* g_view_rest[SOCKET_VIEWS_MAX];
+static size_t g_view_rest_len[SOCKET_VIEWS_MAX];
+static size_t g_view_rest_size[SOCKET_VIEWS_MAX];
+
 /**
  * Helper: Read exactly n bytes from socket.
  * Handles partial reads by looping until all bytes received.
@@ -48,135 +69,373 @@ static int recv_exactly(int fd, void* buffer, size_t n) {
 }
 
 /**
- * Helper: Send exactly n bytes to socket.
- * Handles partial writes by looping until all bytes sent.
+ * Helper: Send every byte described by an iovec array.
+ * One writev() per attempt; on a partial write the array is advanced past
+ * the bytes that went out and the rest is retried.
  *
  * Returns: 0 on success, -1 on error
  */
-static int send_exactly(int fd, const void* buffer, size_t n) {
-    size_t total_sent = 0;
-    const unsigned char* buf = (const unsigned char*)buffer;
+static int send_iov_exactly(int fd, struct iovec* iov, int count) {
+    size_t remaining = 0;
+    for (int i = 0; i < count; i++) {
+        remaining += iov[i].iov_len;
+    }
 
-    while (total_sent < n) {
-        ssize_t bytes_sent = write(fd, buf + total_sent, n - total_sent);
+    while (remaining > 0) {
+        ssize_t bytes_sent = writev(fd, iov, count);
+        g_stats.write_calls++;
 
+        if (bytes_sent < 0 && errno == EINTR) {
+            continue;
+        }
         if (bytes_sent <= 0) {
-            perror("send_exactly: write");
+            perror("send_iov_exactly: writev");
             return -1;
         }
 
-        total_sent += bytes_sent;
+        g_stats.bytes += bytes_sent;
+        remaining -= bytes_sent;
+        if (remaining > 0) {
+            g_stats.partial_writes++;
+        }
+
+        /* Skip fully written entries, trim the partially written one */
+        size_t done = (size_t)bytes_sent;
+        while (count > 0 && done >= iov[0].iov_len) {
+            done -= iov[0].iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov[0].iov_base = (char*)iov[0].iov_base + done;
+            iov[0].iov_len -= done;
+        }
     }
 
     return 0;
 }
 
-int doom_socket_connect(void) {
+/**
+ * Helper: Send one message, prefixed by any pending control messages,
+ * in a single writev(). The payload is records (may be NULL) followed by
+ * json_data.
+ *
+ * Returns: 0 on success, -1 on error
+ */
+static int send_with_pending(uint32_t msg_type, const void* records, size_t records_len,
+                             const char* json_data, size_t len) {
+    uint32_t header[2];
+    struct iovec iov[4];
+    int count = 0;
+
+    header[0] = msg_type;
+    header[1] = (uint32_t)(records_len + len);
+
+    if (g_pending_len > 0) {
+        iov[count].iov_base = g_pending;
+        iov[count].iov_len = g_pending_len;
+        count++;
+    }
+    iov[count].iov_base = header;
+    iov[count].iov_len = sizeof(header);
+    count++;
+    if (records_len > 0) {
+        iov[count].iov_base = (void*)records;
+        iov[count].iov_len = records_len;
+        count++;
+    }
+    if (len > 0) {
+        iov[count].iov_base = (void*)json_data;
+        iov[count].iov_len = len;
+        count++;
+    }
+
+    size_t total = g_pending_len + sizeof(header) + records_len + len;
+    DOOM_TRACE3(send__start, msg_type, records_len + len, g_stats.pending_messages);
+
+    g_stats.messages += 1 + g_stats.pending_messages;
+    g_stats.pending_messages = 0;
+    g_pending_len = 0;
+
+    int result = send_iov_exactly(g_socket_fd, iov, count);
+    DOOM_TRACE3(send__complete, msg_type, total, result);
+    return result;
+}
+
+/**
+ * Helper: Read an unsigned integer field from a flat JSON object.
+ *
+ * Returns: Value, or 0 if absent
+ */
+static uint64_t parse_json_u64(const char* json, const char* key) {
+    const char* p = strstr(json, key);
+    if (p == NULL) {
+        return 0;
+    }
+    p += strlen(key);
+    while (*p == ' ' || *p == '\t') p++;
+    return strtoull(p, NULL, 10);
+}
+
+/**
+ * Helper: Extract the "schema" hash from the INIT_COMPLETE payload.
+ *
+ * Returns: Hash, or 0 if absent
+ */
+static uint64_t parse_schema_hash(const char* json) {
+    const char* p = strstr(json, "\"schema\":");
+    if (p == NULL) {
+        return 0;
+    }
+    p += 9;
+    while (*p == ' ' || *p == '\t' || *p == '"') p++;
+    return strtoull(p, NULL, 16);
+}
+
+/**
+ * Helper: Connect to a socket server and wait for its INIT_COMPLETE.
+ *
+ * Args:
+ *   path: Socket path
+ *   schema: Output - record schema hash from the init payload (0 if none)
+ *
+ * Returns: Connected socket, or -1 on error
+ */
+static int open_connection(const char* path, uint64_t* schema) {
     struct sockaddr_un addr;
     uint32_t msg_type, payload_len;
 
     /* Create socket */
-    g_socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
-    if (g_socket_fd < 0) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
         perror("doom_socket_connect: socket");
         return -1;
     }
 
     /* Set large socket buffers to prevent blocking on large frame data */
     int bufsize = 1048576;  /* 1MB buffer */
-    setsockopt(g_socket_fd, SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
-    setsockopt(g_socket_fd, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
 
     /* Setup address */
     memset(&addr, 0, sizeof(addr));
     addr.sun_family = AF_UNIX;
-    strncpy(addr.sun_path, SOCKET_PATH, sizeof(addr.sun_path) - 1);
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
 
     /* Connect to Python server */
-    printf("Connecting to KiCad Python at %s...\n", SOCKET_PATH);
-    if (connect(g_socket_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    printf("Connecting to KiCad Python at %s...\n", path);
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
         perror("doom_socket_connect: connect");
         fprintf(stderr, "Make sure KiCad plugin is running and socket server started!\n");
-        close(g_socket_fd);
-        g_socket_fd = -1;
+        close(fd);
         return -1;
     }
 
     /* Wait for INIT_COMPLETE message */
     printf("Waiting for INIT_COMPLETE from Python...\n");
 
-    if (recv_exactly(g_socket_fd, &msg_type, sizeof(msg_type)) < 0) {
+    if (recv_exactly(fd, &msg_type, sizeof(msg_type)) < 0) {
         fprintf(stderr, "doom_socket_connect: failed to read message type\n");
-        close(g_socket_fd);
-        g_socket_fd = -1;
+        close(fd);
         return -1;
     }
 
-    if (recv_exactly(g_socket_fd, &payload_len, sizeof(payload_len)) < 0) {
+    if (recv_exactly(fd, &payload_len, sizeof(payload_len)) < 0) {
         fprintf(stderr, "doom_socket_connect: failed to read payload length\n");
-        close(g_socket_fd);
-        g_socket_fd = -1;
+        close(fd);
         return -1;
     }
 
     if (msg_type != MSG_INIT_COMPLETE) {
         fprintf(stderr, "doom_socket_connect: expected INIT_COMPLETE (0x%02x), got 0x%02x\n",
                 MSG_INIT_COMPLETE, msg_type);
-        close(g_socket_fd);
-        g_socket_fd = -1;
+        close(fd);
         return -1;
     }
 
-    /* Discard init payload (empty JSON or acknowledgment) */
+    /* Init payload: {} or {"schema": "<hex>"} from record-aware consumers */
+    *schema = 0;
     if (payload_len > 0) {
-        char* discard_buf = malloc(payload_len);
-        if (discard_buf) {
-            recv_exactly(g_socket_fd, discard_buf, payload_len);
-            free(discard_buf);
+        char* init_buf = malloc(payload_len + 1);
+        if (init_buf) {
+            if (recv_exactly(fd, init_buf, payload_len) == 0) {
+                init_buf[payload_len] = '\0';
+                *schema = parse_schema_hash(init_buf);
+            }
+            free(init_buf);
         }
     }
 
+    return fd;
+}
+
+int doom_socket_connect(void) {
+    g_socket_fd = open_connection(SOCKET_PATH, &g_peer_schema);
+    if (g_socket_fd < 0) {
+        return -1;
+    }
+
     printf("Connected to KiCad successfully!\n");
     return 0;
 }
 
-int doom_socket_send_frame(const char* json_data, size_t len) {
-    uint32_t header[2];
+int doom_socket_connect_view(int view, const char* path) {
+    uint64_t schema;
+
+    if (view < 0 || view >= SOCKET_VIEWS_MAX) {
+        return -1;
+    }
+
+    g_view_fds[view] = open_connection(path, &schema);
+    if (g_view_fds[view] < 0) {
+        return -1;
+    }
+
+    printf("Connected view %d subscriber at %s\n", view + 1, path);
+    return 0;
+}
+
+int doom_socket_view_connected(int view) {
+    return (view >= 0 && view < SOCKET_VIEWS_MAX && g_view_fds[view] >= 0) ? 1 : 0;
+}
+
+/**
+ * Helper: One non-blocking write to a viewpoint subscriber.
+ *
+ * Returns: Bytes written (0 if its buffer is full), -1 on error
+ */
+static ssize_t send_view_nowait(int view, struct iovec* iov, int count) {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(g_view_fds[view], &msg, MSG_DONTWAIT);
+    } while (sent < 0 && errno == EINTR);
+
+    if (sent < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    g_stats.view_bytes += sent;
+    return sent;
+}
+
+/**
+ * Helper: Close a viewpoint subscriber that went away.
+ */
+static void drop_view(int view) {
+    fprintf(stderr, "doom_socket_send_view: view %d disconnected\n", view + 1);
+    close(g_view_fds[view]);
+    g_view_fds[view] = -1;
+    g_view_rest_len[view] = 0;
+}
+
+int doom_socket_send_view(int view, const char* json_data, size_t len) {
+    if (view < 0 || view >= SOCKET_VIEWS_MAX || g_view_fds[view] < 0) {
+        return -1;
+    }
+
+    /* Finish the previous frame first; while it can't go out, skip frames */
+    if (g_view_rest_len[view] > 0) {
+        struct iovec rest = { g_view_rest[view], g_view_rest_len[view] };
+        ssize_t sent = send_view_nowait(view, &rest, 1);
+        if (sent < 0) {
+            drop_view(view);
+            return -1;
+        }
+        g_view_rest_len[view] -= sent;
+        memmove(g_view_rest[view], g_view_rest[view] + sent, g_view_rest_len[view]);
+        if (g_view_rest_len[view] > 0) {
+            g_stats.view_dropped++;
+            return 0;
+        }
+    }
+
+    uint32_t header[2] = { MSG_FRAME_DATA, (uint32_t)len };
+    struct iovec iov[2] = {
+        { header, sizeof(header) },
+        { (void*)json_data, len },
+    };
+
+    ssize_t sent = send_view_nowait(view, iov, 2);
+    if (sent < 0) {
+        drop_view(view);
+        return -1;
+    }
+    if (sent == 0) {
+        g_stats.view_dropped++;
+        return 0;
+    }
+    g_stats.view_frames++;
+
+    /* Partially written: keep the tail so the stream stays in sync */
+    size_t total = sizeof(header) + len;
+    if ((size_t)sent < total) {
+        size_t rest = total - sent;
+        if (rest > g_view_rest_size[view]) {
+            char* grown = realloc(g_view_rest[view], rest);
+            if (grown == NULL) {
+                drop_view(view);
+                return -1;
+            }
+            g_view_rest[view] = grown;
+            g_view_rest_size[view] = rest;
+        }
+        size_t header_rest = (size_t)sent < sizeof(header) ? sizeof(header) - sent : 0;
+        memcpy(g_view_rest[view], (char*)header + sizeof(header) - header_rest, header_rest);
+        memcpy(g_view_rest[view] + header_rest, json_data + (len - (rest - header_rest)),
+               rest - header_rest);
+        g_view_rest_len[view] = rest;
+    }
+    return 0;
+}
 
+int doom_socket_send_frame(const char* json_data, size_t len) {
     if (g_socket_fd < 0) {
         fprintf(stderr, "doom_socket_send_frame: not connected\n");
         return -1;
     }
 
-    /* Build message header */
-    header[0] = MSG_FRAME_DATA;
-    header[1] = (uint32_t)len;
+    /* Header, payload and queued control messages in one syscall */
+    if (send_with_pending(MSG_FRAME_DATA, NULL, 0, json_data, len) < 0) {
+        fprintf(stderr, "doom_socket_send_frame: failed to send frame\n");
+        return -1;
+    }
 
-    /* Send header */
-    if (send_exactly(g_socket_fd, header, sizeof(header)) < 0) {
-        fprintf(stderr, "doom_socket_send_frame: failed to send header\n");
+    g_stats.frames++;
+    return 0;
+}
+
+int doom_socket_send_records(const void* records, size_t records_len,
+                             const char* json_data, size_t len) {
+    if (g_socket_fd < 0) {
+        fprintf(stderr, "doom_socket_send_records: not connected\n");
         return -1;
     }
 
-    /* Send JSON payload */
-    if (send_exactly(g_socket_fd, json_data, len) < 0) {
-        fprintf(stderr, "doom_socket_send_frame: failed to send payload\n");
+    if (send_with_pending(MSG_FRAME_RECORDS, records, records_len, json_data, len) < 0) {
+        fprintf(stderr, "doom_socket_send_records: failed to send frame\n");
         return -1;
     }
 
+    g_stats.frames++;
     return 0;
 }
 
-int doom_socket_recv_key(int* pressed, unsigned char* key) {
+uint64_t doom_socket_peer_schema(void) {
+    return g_peer_schema;
+}
+
+/**
+ * Helper: Read the next message header if data is waiting (non-blocking).
+ *
+ * Returns: 1 if a header was read, 0 if no data available, -1 on error
+ */
+static int poll_header(uint32_t* msg_type, uint32_t* payload_len) {
     fd_set readfds;
     struct timeval tv;
-    uint32_t msg_type, payload_len;
-    char json_buf[256];  /* Key events are small */
-    int ret;
-
-    if (g_socket_fd < 0) {
-        return 0;  /* Not connected, no keys */
-    }
 
     /* Non-blocking check for data (zero timeout) */
     FD_ZERO(&readfds);
@@ -184,37 +443,124 @@ int doom_socket_recv_key(int* pressed, unsigned char* key) {
     tv.tv_sec = 0;
     tv.tv_usec = 0;
 
-    ret = select(g_socket_fd + 1, &readfds, NULL, NULL, &tv);
-    if (ret <= 0) {
+    if (select(g_socket_fd + 1, &readfds, NULL, NULL, &tv) <= 0) {
         /* No data available or error */
         return 0;
     }
 
     /* Data available - read message header */
-    if (recv_exactly(g_socket_fd, &msg_type, sizeof(msg_type)) < 0) {
+    if (recv_exactly(g_socket_fd, msg_type, sizeof(*msg_type)) < 0) {
+        return -1;
+    }
+    if (recv_exactly(g_socket_fd, payload_len, sizeof(*payload_len)) < 0) {
         return -1;
     }
+    return 1;
+}
+
+/**
+ * Helper: Read and drop a payload, keeping the stream in sync.
+ *
+ * Returns: 0 on success, -1 on error or if the length is implausible
+ */
+static int discard_payload(uint32_t payload_len) {
+    char discard_buf[1024];
+
+    if (payload_len >= 65536) {
+        fprintf(stderr, "doom_socket_recv_key: payload too large (%u bytes)\n", payload_len);
+        return -1;  /* Not a real message: the stream is lost */
+    }
+    while (payload_len > 0) {
+        uint32_t chunk = payload_len < sizeof(discard_buf) ? payload_len : sizeof(discard_buf);
+        if (recv_exactly(g_socket_fd, discard_buf, chunk) < 0) {
+            return -1;
+        }
+        payload_len -= chunk;
+    }
+    return 0;
+}
 
-    if (recv_exactly(g_socket_fd, &payload_len, sizeof(payload_len)) < 0) {
+/**
+ * Helper: Read a MSG_PRESENT_FEEDBACK payload and hand it to the pacing
+ * controller: {"frame": N, "wait_us": ..., "decode_us": ..., "render_us": ...,
+ * "interval_us": ...}
+ *
+ * Returns: 0 on success, -1 on error
+ */
+static int recv_feedback(uint32_t payload_len) {
+    char json_buf[256];
+
+    if (payload_len >= sizeof(json_buf)) {
+        fprintf(stderr, "doom_socket_recv_key: feedback too large (%u bytes)\n", payload_len);
         return -1;
     }
+    if (recv_exactly(g_socket_fd, json_buf, payload_len) < 0) {
+        return -1;
+    }
+    json_buf[payload_len] = '\0';
+
+    doom_pacing_feedback((int)parse_json_u64(json_buf, "\"frame\":"),
+                         parse_json_u64(json_buf, "\"wait_us\":"),
+                         parse_json_u64(json_buf, "\"decode_us\":"),
+                         parse_json_u64(json_buf, "\"render_us\":"),
+                         parse_json_u64(json_buf, "\"interval_us\":"));
+    return 0;
+}
+
+int doom_socket_recv_key(int* pressed, unsigned char* key) {
+    uint32_t msg_type, payload_len;
+    char json_buf[256];  /* Key events are small */
+    int ret;
+
+    /* Events left over from the last input snapshot go first */
+    if (doom_input_next_event(pressed, key)) {
+        DOOM_TRACE2(key__event, *pressed, *key);
+        return 1;
+    }
+
+    if (g_socket_fd < 0) {
+        return 0;  /* Not connected, no keys */
+    }
+
+    /* Present feedback is consumed on the way to the next input message */
+    while ((ret = poll_header(&msg_type, &payload_len)) > 0 && msg_type == MSG_PRESENT_FEEDBACK) {
+        if (recv_feedback(payload_len) < 0) {
+            return -1;
+        }
+    }
+    if (ret <= 0) {
+        return ret;  /* No data (0) or error (-1) */
+    }
 
     /* Check message type */
     if (msg_type == MSG_SHUTDOWN) {
         printf("Received SHUTDOWN message from Python\n");
+        /* The consumer is going away: close without sending our own */
+        close(g_socket_fd);
+        g_socket_fd = -1;
         return -1;
     }
 
+    if (msg_type == MSG_INPUT_STATE) {
+        uint8_t state[INPUT_STATE_SIZE];
+        if (payload_len != INPUT_STATE_SIZE) {
+            fprintf(stderr, "doom_socket_recv_key: bad input state size (%u bytes)\n", payload_len);
+            return discard_payload(payload_len);
+        }
+        if (recv_exactly(g_socket_fd, state, payload_len) < 0) {
+            return -1;
+        }
+        doom_input_apply_state(state, payload_len);
+        if (doom_input_next_event(pressed, key)) {
+            DOOM_TRACE2(key__event, *pressed, *key);
+            return 1;
+        }
+        return 0;  /* Unchanged or out of date */
+    }
+
     if (msg_type != MSG_KEY_EVENT) {
         /* Unknown message type - discard payload and continue */
-        if (payload_len > 0 && payload_len < 65536) {
-            char* discard_buf = malloc(payload_len);
-            if (discard_buf) {
-                recv_exactly(g_socket_fd, discard_buf, payload_len);
-                free(discard_buf);
-            }
-        }
-        return 0;
+        return discard_payload(payload_len);
     }
 
     /* Read key event payload */
@@ -257,15 +603,18 @@ int doom_socket_recv_key(int* pressed, unsigned char* key) {
     /* Output values */
     *pressed = pressed_val;
     *key = (unsigned char)key_val;
+    if (!doom_input_note_key(pressed_val, *key)) {
+        return 0;  /* Still held in the window */
+    }
+    DOOM_TRACE2(key__event, pressed_val, key_val);
 
     return 1;  /* Key event received */
 }
 
 void doom_socket_close(void) {
     if (g_socket_fd >= 0) {
-        /* Send shutdown message */
-        uint32_t header[2] = {MSG_SHUTDOWN, 0};
-        write(g_socket_fd, header, sizeof(header));
+        /* Send shutdown message (after anything still queued) */
+        send_with_pending(MSG_SHUTDOWN, NULL, 0, NULL, 0);
 
         /* Close socket */
         close(g_socket_fd);
@@ -273,6 +622,23 @@ void doom_socket_close(void) {
 
         printf("Socket connection closed\n");
     }
+
+    for (int i = 0; i < SOCKET_VIEWS_MAX; i++) {
+        if (g_view_fds[i] >= 0) {
+            /* Best effort: not after half a frame, and never waiting */
+            uint32_t header[2] = { MSG_SHUTDOWN, 0 };
+            struct iovec iov = { header, sizeof(header) };
+            if (g_view_rest_len[i] == 0) {
+                send_view_nowait(i, &iov, 1);
+            }
+            close(g_view_fds[i]);
+            g_view_fds[i] = -1;
+        }
+        free(g_view_rest[i]);
+        g_view_rest[i] = NULL;
+        g_view_rest_len[i] = 0;
+        g_view_rest_size[i] = 0;
+    }
 }
 
 int doom_socket_is_connected(void) {
@@ -280,28 +646,42 @@ int doom_socket_is_connected(void) {
 }
 
 int doom_socket_send_message(uint32_t msg_type, const char* json_data, size_t len) {
-    uint32_t header[2];
-
     if (g_socket_fd < 0) {
         fprintf(stderr, "doom_socket_send_message: not connected\n");
         return -1;
     }
 
-    /* Build message header */
-    header[0] = msg_type;
-    header[1] = (uint32_t)len;
-
-    /* Send header */
-    if (send_exactly(g_socket_fd, header, sizeof(header)) < 0) {
-        fprintf(stderr, "doom_socket_send_message: failed to send header\n");
+    if (send_with_pending(msg_type, NULL, 0, json_data, len) < 0) {
+        fprintf(stderr, "doom_socket_send_message: failed to send message\n");
         return -1;
     }
 
-    /* Send JSON payload */
-    if (send_exactly(g_socket_fd, json_data, len) < 0) {
-        fprintf(stderr, "doom_socket_send_message: failed to send payload\n");
+    return 0;
+}
+
+int doom_socket_queue_message(uint32_t msg_type, const char* json_data, size_t len) {
+    uint32_t header[2];
+
+    if (g_socket_fd < 0) {
+        fprintf(stderr, "doom_socket_queue_message: not connected\n");
         return -1;
     }
 
+    /* Too big to batch - send it (and anything already queued) right away */
+    if (g_pending_len + sizeof(header) + len > sizeof(g_pending)) {
+        return doom_socket_send_message(msg_type, json_data, len);
+    }
+
+    header[0] = msg_type;
+    header[1] = (uint32_t)len;
+    memcpy(g_pending + g_pending_len, header, sizeof(header));
+    memcpy(g_pending + g_pending_len + sizeof(header), json_data, len);
+    g_pending_len += sizeof(header) + len;
+    g_stats.pending_messages++;
+
     return 0;
 }
+
+void doom_socket_get_stats(socket_stats_t* out) {
+    *out = g_stats;
+}
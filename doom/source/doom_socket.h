@@ -21,21 +21,87 @@
 #define MSG_INIT_COMPLETE 0x03  /* Python → DOOM: Connection established */
 #define MSG_SHUTDOWN      0x04  /* Bidirectional: Clean shutdown */
 #define MSG_SCREENSHOT    0x05  /* DOOM → Python: SDL screenshot saved, request combine */
+#define MSG_HEARTBEAT     0x06  /* DOOM → Python: Alive, last frame still current */
+#define MSG_FRAME_RECORDS 0x07  /* DOOM → Python: Frame as binary records + JSON tail */
+#define MSG_INPUT_STATE   0x08  /* Python → DOOM: Held keys bitmap + sequence (doom_input.h) */
+#define MSG_PRESENT_FEEDBACK 0x09  /* Python → DOOM: Frame presented, wait/decode/render times (doom_pacing.h) */
 
 /* Socket path (must match Python side) */
 #define SOCKET_PATH "/tmp/kicad_doom.sock"
 
+/* Extra viewpoint subscribers (-view) */
+#define SOCKET_VIEWS_MAX 8
+
+/* Buffer for control messages batched into the next frame write */
+#define SOCKET_PENDING_MAX 4096
+
+/* Transport counters (cumulative since connect) */
+typedef struct {
+    uint64_t frames;            /* Frame messages sent (JSON or records) */
+    uint64_t messages;          /* All messages sent, including batched ones */
+    uint64_t bytes;             /* Bytes written */
+    uint64_t write_calls;       /* writev() syscalls */
+    uint64_t partial_writes;    /* writev() calls that didn't send everything */
+    uint64_t pending_messages;  /* Currently queued control messages */
+
+    /* Viewpoint subscribers (-view), not included above */
+    uint64_t view_frames;       /* Frames written (or started) to subscribers */
+    uint64_t view_dropped;      /* Frames skipped for a subscriber that was behind */
+    uint64_t view_bytes;        /* Bytes written to subscribers */
+} socket_stats_t;
+
 /**
  * Connect to Python KiCad socket server.
  * Blocks until connection is established and INIT_COMPLETE is received.
+ * A "schema" hash in the INIT_COMPLETE payload is kept for
+ * doom_socket_peer_schema().
  *
  * Returns: 0 on success, -1 on error
  */
 int doom_socket_connect(void);
 
+/**
+ * Connect an extra viewpoint subscriber. Same handshake as
+ * doom_socket_connect(), but the connection is send-only: no keys are
+ * read from it and it only receives JSON frames.
+ *
+ * Args:
+ *   view: View index (0..SOCKET_VIEWS_MAX-1)
+ *   path: Socket path the subscriber listens on
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int doom_socket_connect_view(int view, const char* path);
+
+/**
+ * Check if a viewpoint subscriber is connected.
+ *
+ * Returns: 1 if connected, 0 if not
+ */
+int doom_socket_view_connected(int view);
+
+/**
+ * Send a MSG_FRAME_DATA frame to a viewpoint subscriber without blocking.
+ * A subscriber whose socket buffer is full (still busy with earlier frames)
+ * misses this frame; one that has gone away is closed and skipped from then
+ * on. The game loop never waits for either.
+ *
+ * Returns: 0 if sent or skipped, -1 on error or if the view isn't connected
+ */
+int doom_socket_send_view(int view, const char* json_data, size_t len);
+
+/**
+ * Frame record schema hash the consumer announced in INIT_COMPLETE
+ * ({"schema": "<16 hex digits>"}).
+ *
+ * Returns: Hash, or 0 if the consumer only understands JSON frames
+ */
+uint64_t doom_socket_peer_schema(void);
+
 /**
  * Send frame data to Python renderer.
- * Frame data must be formatted as JSON string.
+ * Frame data must be formatted as JSON string. Header, payload and any
+ * queued control messages go out in a single writev() call.
  *
  * Args:
  *   json_data: JSON string containing frame data
@@ -45,9 +111,27 @@ int doom_socket_connect(void);
  */
 int doom_socket_send_frame(const char* json_data, size_t len);
 
+/**
+ * Send a MSG_FRAME_RECORDS frame: packed records followed by the JSON tail,
+ * as one message (and one writev(), like doom_socket_send_frame).
+ *
+ * Args:
+ *   records: Packed frame records (see doom_records.h)
+ *   records_len: Length of records in bytes
+ *   json_data: JSON object with the rest of the frame
+ *   len: Length of json_data in bytes
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int doom_socket_send_records(const void* records, size_t records_len,
+                             const char* json_data, size_t len);
+
 /**
  * Receive keyboard event from Python (non-blocking).
  * Uses select() with zero timeout - returns immediately if no data available.
+ * Handles both single key events and input state snapshots; a snapshot
+ * can yield several events, returned by the following calls. Present
+ * feedback messages read on the way are passed to doom_pacing_feedback().
  *
  * Args:
  *   pressed: Output - 1 if key pressed, 0 if released
@@ -58,7 +142,8 @@ int doom_socket_send_frame(const char* json_data, size_t len);
 int doom_socket_recv_key(int* pressed, unsigned char* key);
 
 /**
- * Close socket connection and send shutdown message.
+ * Close socket connection (and any viewpoint subscribers) and send
+ * shutdown message.
  * Safe to call multiple times.
  */
 void doom_socket_close(void);
@@ -83,4 +168,23 @@ int doom_socket_is_connected(void);
  */
 int doom_socket_send_message(uint32_t msg_type, const char* json_data, size_t len);
 
+/**
+ * Queue a small control message to be sent together with the next frame
+ * (or message), saving its own syscall. Messages that don't fit the
+ * batch buffer are sent immediately.
+ *
+ * Args:
+ *   msg_type: Message type constant (e.g. MSG_SCREENSHOT)
+ *   json_data: JSON string payload (copied)
+ *   len: Length of json_data in bytes
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int doom_socket_queue_message(uint32_t msg_type, const char* json_data, size_t len);
+
+/**
+ * Copy the transport counters (syscalls, bytes, messages).
+ */
+void doom_socket_get_stats(socket_stats_t* out);
+
 #endif /* DOOM_SOCKET_H */
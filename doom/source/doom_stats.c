@@ -0,0 +1,89 @@
+/**
+ * doom_stats.c
+ *
+ * Shared-memory stats page (sequence-lock writer).
+ */
+
+#include "doom_stats.h"
+#include "doom_clock.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "doomtype.h"
+#include "i_system.h"
+
+#define STATS_NAME_MAX 64
+
+static stats_page_t* g_page = NULL;
+static char g_name[STATS_NAME_MAX];
+
+/**
+ * Helper: Unmap and remove the segment (registered with I_AtExit).
+ */
+static void stats_shutdown(void) {
+    if (g_page == NULL) {
+        return;
+    }
+    munmap(g_page, sizeof(stats_page_t));
+    g_page = NULL;
+    shm_unlink(g_name);
+}
+
+int doom_stats_start(const char* name) {
+    snprintf(g_name, sizeof(g_name), "%s", name);
+
+    int fd = shm_open(g_name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        perror("doom_stats_start: shm_open");
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(stats_page_t)) < 0) {
+        perror("doom_stats_start: ftruncate");
+        close(fd);
+        return -1;
+    }
+
+    void* page = mmap(NULL, sizeof(stats_page_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (page == MAP_FAILED) {
+        perror("doom_stats_start: mmap");
+        return -1;
+    }
+
+    g_page = (stats_page_t*)page;
+    memset(g_page, 0, sizeof(stats_page_t));
+    g_page->version = STATS_VERSION;
+    g_page->size = sizeof(stats_page_t);
+    g_page->pid = (int32_t)getpid();
+    g_page->values.start_us = doom_clock_us();
+    __atomic_store_n(&g_page->magic, STATS_MAGIC, __ATOMIC_RELEASE);  /* Valid from here */
+
+    I_AtExit(stats_shutdown, true);
+    printf("✓ Stats page: %s (watch with doom_top)\n", g_name);
+    return 0;
+}
+
+void doom_stats_publish(const stats_values_t* values) {
+    if (g_page == NULL) {
+        return;
+    }
+
+    /* Single writer: odd sequence, stores, even sequence. Readers that
+     * overlap an update see the sequence change and retry on their side. */
+    const uint64_t* src = (const uint64_t*)values;
+    uint64_t* dst = (uint64_t*)&g_page->values;
+    uint32_t seq = g_page->seq;
+    uint64_t start_us = g_page->values.start_us;
+
+    __atomic_store_n(&g_page->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (unsigned int i = 0; i < STATS_VALUE_COUNT; i++) {
+        __atomic_store_n(&dst[i], src[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&g_page->values.start_us, start_us, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_page->seq, seq + 2, __ATOMIC_RELEASE);
+}
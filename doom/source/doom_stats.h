@@ -0,0 +1,116 @@
+/**
+ * doom_stats.h
+ *
+ * Live statistics page in POSIX shared memory (-statsshm [/name]).
+ *
+ * Every frame DOOM publishes frame rate inputs, per-phase timings, payload
+ * sizes, skipped/late frames, queue depths and wall/sprite counts into a
+ * small named segment, protected by a sequence lock: the writer never waits
+ * and never learns whether anyone is reading. doom_top (doom_top.c) maps
+ * the segment read-only and displays it at any interval.
+ *
+ * This header is shared with doom_top and doesn't depend on the engine.
+ */
+
+#ifndef DOOM_STATS_H
+#define DOOM_STATS_H
+
+#include <stdint.h>
+
+#define STATS_SHM_DEFAULT "/kidoom_stats"
+#define STATS_MAGIC       0x4b445354u  /* "KDST" */
+#define STATS_VERSION     2
+
+/* Late frame: work time (tic + render + extract + send + present) over one tic */
+#define STATS_LATE_US     28571
+
+/* All values are uint64_t so the page can be copied word by word */
+typedef struct {
+    uint64_t frame;             /* Frames drawn */
+    uint64_t tic;               /* Game tic */
+    uint64_t time_us;           /* Monotonic clock at publication */
+    uint64_t start_us;          /* Monotonic clock when stats started */
+
+    uint64_t frames_sent;       /* Frame messages sent */
+    uint64_t idle_skipped;      /* Frames not sent (-skipidle) */
+    uint64_t late_frames;       /* Frames whose work time exceeded STATS_LATE_US */
+
+    uint64_t game_us;           /* Last frame: tics + 3D render (between frames) */
+    uint64_t extract_us;        /* Last frame: extraction + encoding */
+    uint64_t send_us;           /* Last frame: socket write */
+    uint64_t present_us;        /* Last frame: SDL presentation + input */
+    uint64_t work_us;           /* Last frame: total of the above */
+    uint64_t work_max_us;       /* Worst frame so far */
+
+    uint64_t frame_bytes;       /* Last frame payload */
+    uint64_t bytes_total;       /* Bytes written to the socket */
+    uint64_t write_calls;       /* writev() calls */
+
+    uint64_t pending_messages;  /* Control messages waiting for the next frame */
+    uint64_t export_queue;      /* Frames waiting for export workers */
+
+    uint64_t walls;             /* Walls in the last frame */
+    uint64_t sprites;           /* Sprites in the last frame */
+    uint64_t view_width;        /* 3D view size (changes under -dynres) */
+    uint64_t view_height;
+
+    uint64_t queue_us;          /* Consumer-reported wait before pickup (average) */
+    uint64_t consumer_us;       /* Consumer pickup -> presented (average) */
+    uint64_t pacing_us;         /* -pacing delay before this frame */
+} stats_values_t;
+
+#define STATS_VALUE_COUNT (sizeof(stats_values_t) / sizeof(uint64_t))
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;              /* sizeof(stats_page_t) */
+    int32_t pid;                /* Publishing DOOM process */
+    uint32_t seq;               /* Sequence lock: odd while an update is in progress */
+    uint32_t reserved;
+    stats_values_t values;
+} stats_page_t;
+
+/**
+ * Create (or reuse) the shared-memory segment and start publishing.
+ * Registers an exit handler that unlinks it.
+ *
+ * Args:
+ *   name: Segment name, e.g. STATS_SHM_DEFAULT
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int doom_stats_start(const char* name);
+
+/**
+ * Publish a snapshot (no-op unless started). Never blocks.
+ */
+void doom_stats_publish(const stats_values_t* values);
+
+/**
+ * Read a consistent snapshot from a mapped page (reader side; used by
+ * doom_top). Retries while the writer is mid-update.
+ *
+ * Returns: 0 on success, -1 if no consistent copy could be taken
+ */
+static inline int doom_stats_read(const stats_page_t* page, stats_values_t* out) {
+    const uint64_t* src = (const uint64_t*)&page->values;
+    uint64_t* dst = (uint64_t*)out;
+
+    for (int attempt = 0; attempt < 1000; attempt++) {
+        uint32_t before = __atomic_load_n(&page->seq, __ATOMIC_ACQUIRE);
+        if (before & 1) {
+            continue;
+        }
+        for (unsigned int i = 0; i < STATS_VALUE_COUNT; i++) {
+            dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&page->seq, __ATOMIC_RELAXED) == before) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+#endif /* DOOM_STATS_H */
@@ -0,0 +1,288 @@
+/**
+ * doom_telemetry.c
+ *
+ * Per-map histograms of frame contents and the JSON report.
+ *
+ * Walls and sprites are bounded by MAXDRAWSEGS / MAXVISSPRITES, so their
+ * histograms have one bucket per count and percentiles are exact. Payload
+ * bytes use TELEMETRY_BYTES_BUCKET-sized buckets; byte percentiles are the
+ * upper edge of their bucket (never below the true value, capped at the
+ * exact maximum).
+ */
+
+#include "doom_telemetry.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "doomdef.h"
+#include "doomstat.h"
+#include "i_system.h"
+#include "r_defs.h"
+#include "r_things.h"
+
+#define BYTES_BUCKETS (TELEMETRY_BYTES_MAX / TELEMETRY_BYTES_BUCKET + 1)
+
+typedef struct {
+    char name[9];
+    uint32_t frames;
+
+    uint32_t walls[MAXDRAWSEGS + 1];
+    uint32_t sprites[MAXVISSPRITES + 1];
+    uint32_t bytes[BYTES_BUCKETS];
+    size_t bytes_max;
+
+    int drawsegs_max;
+    int vissprites_max;
+    uint32_t drawsegs_full;     /* Frames that used every drawseg */
+    uint32_t vissprites_full;   /* Frames that used every vissprite */
+} map_telemetry_t;
+
+static FILE* g_file = NULL;
+static char g_path[256];
+
+static map_telemetry_t g_maps[TELEMETRY_MAX_MAPS];
+static int g_map_count = 0;
+
+/* Map of the last frame (maps only change between levels) */
+static map_telemetry_t* g_current = NULL;
+static int g_current_episode = -1;
+static int g_current_map = -1;
+
+/* All maps, filled in at exit */
+static map_telemetry_t g_total;
+
+/**
+ * Helper: Telemetry slot for the map on screen, NULL once the table is full.
+ */
+static map_telemetry_t* current_map(void) {
+    if (g_current != NULL && gameepisode == g_current_episode && gamemap == g_current_map) {
+        return g_current;
+    }
+
+    /* Same naming as G_DoLoadLevel() */
+    char name[9];
+    if (gamemode == commercial) {
+        snprintf(name, sizeof(name), "MAP%02d", gamemap);
+    } else {
+        snprintf(name, sizeof(name), "E%dM%d", gameepisode, gamemap);
+    }
+
+    g_current = NULL;
+    for (int i = 0; i < g_map_count; i++) {
+        if (!strcmp(g_maps[i].name, name)) {
+            g_current = &g_maps[i];
+        }
+    }
+    if (g_current == NULL && g_map_count < TELEMETRY_MAX_MAPS) {
+        g_current = &g_maps[g_map_count++];
+        snprintf(g_current->name, sizeof(g_current->name), "%s", name);
+    }
+
+    g_current_episode = gameepisode;
+    g_current_map = gamemap;
+    return g_current;
+}
+
+/**
+ * Helper: Smallest bucket holding at least the given fraction of the frames.
+ */
+static int percentile(const uint32_t* histogram, int buckets, uint32_t frames, double fraction) {
+    uint64_t target = (uint64_t)(frames * fraction + 0.999999);
+    uint64_t seen = 0;
+
+    if (target == 0) {
+        target = 1;
+    }
+    for (int i = 0; i < buckets; i++) {
+        seen += histogram[i];
+        if (seen >= target) {
+            return i;
+        }
+    }
+    return buckets - 1;
+}
+
+/**
+ * Helper: Write a count histogram: percentiles, maximum and the non-empty
+ * buckets as [count, frames] pairs.
+ */
+static void write_counts(FILE* f, const char* key, const uint32_t* histogram, int buckets,
+                         uint32_t frames) {
+    int max = 0;
+    for (int i = 0; i < buckets; i++) {
+        if (histogram[i] != 0) {
+            max = i;
+        }
+    }
+
+    fprintf(f, "      \"%s\": {\"p50\": %d, \"p95\": %d, \"p99\": %d, \"max\": %d, \"histogram\": [",
+            key, percentile(histogram, buckets, frames, 0.50),
+            percentile(histogram, buckets, frames, 0.95),
+            percentile(histogram, buckets, frames, 0.99), max);
+
+    const char* sep = "";
+    for (int i = 0; i < buckets; i++) {
+        if (histogram[i] != 0) {
+            fprintf(f, "%s[%d, %u]", sep, i, histogram[i]);
+            sep = ", ";
+        }
+    }
+    fprintf(f, "]},\n");
+}
+
+/**
+ * Helper: Payload percentile in bytes (upper edge of its bucket, at most
+ * the largest frame).
+ */
+static size_t bytes_percentile(const map_telemetry_t* m, double fraction) {
+    size_t bytes = (size_t)(percentile(m->bytes, BYTES_BUCKETS, m->frames, fraction) + 1) *
+                   TELEMETRY_BYTES_BUCKET;
+    return bytes < m->bytes_max ? bytes : m->bytes_max;
+}
+
+/**
+ * Helper: Write one map (or the total) as a JSON object.
+ */
+static void write_map(FILE* f, const map_telemetry_t* m, int last) {
+    fprintf(f, "    {\n      \"map\": \"%s\",\n      \"frames\": %u,\n", m->name, m->frames);
+
+    write_counts(f, "walls", m->walls, MAXDRAWSEGS + 1, m->frames);
+    write_counts(f, "sprites", m->sprites, MAXVISSPRITES + 1, m->frames);
+
+    fprintf(f, "      \"bytes\": {\"p50\": %zu, \"p95\": %zu, \"p99\": %zu, \"max\": %zu, "
+               "\"bucket\": %d, \"histogram\": [",
+            bytes_percentile(m, 0.50), bytes_percentile(m, 0.95), bytes_percentile(m, 0.99),
+            m->bytes_max, TELEMETRY_BYTES_BUCKET);
+    const char* sep = "";
+    for (int i = 0; i < BYTES_BUCKETS; i++) {
+        if (m->bytes[i] != 0) {
+            fprintf(f, "%s[%d, %u]", sep, i * TELEMETRY_BYTES_BUCKET, m->bytes[i]);
+            sep = ", ";
+        }
+    }
+    fprintf(f, "]},\n");
+
+    fprintf(f, "      \"drawsegs_max\": %d,\n      \"drawsegs_full\": %u,\n",
+            m->drawsegs_max, m->drawsegs_full);
+    fprintf(f, "      \"vissprites_max\": %d,\n      \"vissprites_full\": %u\n",
+            m->vissprites_max, m->vissprites_full);
+    fprintf(f, "    }%s\n", last ? "" : ",");
+}
+
+/**
+ * Helper: Add one map's histograms to the total.
+ */
+static void add_to_total(const map_telemetry_t* m) {
+    g_total.frames += m->frames;
+    for (int i = 0; i <= MAXDRAWSEGS; i++) {
+        g_total.walls[i] += m->walls[i];
+    }
+    for (int i = 0; i <= MAXVISSPRITES; i++) {
+        g_total.sprites[i] += m->sprites[i];
+    }
+    for (int i = 0; i < BYTES_BUCKETS; i++) {
+        g_total.bytes[i] += m->bytes[i];
+    }
+    if (m->bytes_max > g_total.bytes_max) {
+        g_total.bytes_max = m->bytes_max;
+    }
+    if (m->drawsegs_max > g_total.drawsegs_max) {
+        g_total.drawsegs_max = m->drawsegs_max;
+    }
+    if (m->vissprites_max > g_total.vissprites_max) {
+        g_total.vissprites_max = m->vissprites_max;
+    }
+    g_total.drawsegs_full += m->drawsegs_full;
+    g_total.vissprites_full += m->vissprites_full;
+}
+
+/**
+ * Exit handler: print the per-map summary and write the report.
+ */
+static void telemetry_shutdown(void) {
+    snprintf(g_total.name, sizeof(g_total.name), "all");
+    for (int i = 0; i < g_map_count; i++) {
+        add_to_total(&g_maps[i]);
+    }
+
+    printf("\nTelemetry (p99 / max per frame):\n");
+    for (int i = 0; i <= g_map_count; i++) {
+        const map_telemetry_t* m = i < g_map_count ? &g_maps[i] : &g_total;
+        if (m->frames == 0) {
+            continue;
+        }
+        printf("  %-5s %6u frames  walls %3d / %3d  sprites %3d / %3d  %.1f / %.1f KB  "
+               "drawsegs max %d/%d  vissprites max %d/%d\n",
+               m->name, m->frames,
+               percentile(m->walls, MAXDRAWSEGS + 1, m->frames, 0.99),
+               percentile(m->walls, MAXDRAWSEGS + 1, m->frames, 1.0),
+               percentile(m->sprites, MAXVISSPRITES + 1, m->frames, 0.99),
+               percentile(m->sprites, MAXVISSPRITES + 1, m->frames, 1.0),
+               bytes_percentile(m, 0.99) / 1024.0,
+               m->bytes_max / 1024.0,
+               m->drawsegs_max, MAXDRAWSEGS, m->vissprites_max, MAXVISSPRITES);
+    }
+
+    fprintf(g_file, "{\n  \"drawsegs_limit\": %d,\n  \"vissprites_limit\": %d,\n",
+            MAXDRAWSEGS, MAXVISSPRITES);
+    fprintf(g_file, "  \"total\":\n");
+    write_map(g_file, &g_total, 0);
+    fprintf(g_file, "  \"maps\": [\n");
+    for (int i = 0; i < g_map_count; i++) {
+        write_map(g_file, &g_maps[i], i == g_map_count - 1);
+    }
+    fprintf(g_file, "  ]\n}\n");
+    fclose(g_file);
+    g_file = NULL;
+
+    printf("✓ Telemetry report written: %s\n", g_path);
+}
+
+int doom_telemetry_start(const char* path) {
+    /* Created up front so a bad path fails now, not after a long replay */
+    g_file = fopen(path, "w");
+    if (g_file == NULL) {
+        fprintf(stderr, "doom_telemetry_start: cannot create %s\n", path);
+        return -1;
+    }
+    snprintf(g_path, sizeof(g_path), "%s", path);
+
+    I_AtExit(telemetry_shutdown, true);
+    printf("✓ Frame telemetry: per-map report in %s on exit\n", g_path);
+    return 0;
+}
+
+void doom_telemetry_frame(int walls, int sprites, size_t bytes, int drawsegs, int vissprites) {
+    if (g_file == NULL) {
+        return;
+    }
+    map_telemetry_t* m = current_map();
+    if (m == NULL) {
+        return;
+    }
+
+    m->frames++;
+    m->walls[walls < MAXDRAWSEGS ? walls : MAXDRAWSEGS]++;
+    m->sprites[sprites < MAXVISSPRITES ? sprites : MAXVISSPRITES]++;
+
+    size_t bucket = bytes / TELEMETRY_BYTES_BUCKET;
+    m->bytes[bucket < BYTES_BUCKETS ? bucket : BYTES_BUCKETS - 1]++;
+    if (bytes > m->bytes_max) {
+        m->bytes_max = bytes;
+    }
+
+    if (drawsegs > m->drawsegs_max) {
+        m->drawsegs_max = drawsegs;
+    }
+    if (vissprites > m->vissprites_max) {
+        m->vissprites_max = vissprites;
+    }
+    if (drawsegs >= MAXDRAWSEGS) {
+        m->drawsegs_full++;
+    }
+    if (vissprites >= MAXVISSPRITES) {
+        m->vissprites_full++;
+    }
+}
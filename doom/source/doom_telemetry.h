@@ -0,0 +1,49 @@
+/**
+ * doom_telemetry.h
+ *
+ * Per-map frame size telemetry (-telemetry <file>).
+ *
+ * Consumer pools (MAX_WALL_TRACES, MAX_ENTITIES in the plugin) and socket
+ * buffers are sized from what frames actually contain. For every map this
+ * module keeps histograms of emitted walls, emitted sprites and payload bytes
+ * per frame, plus the high-water marks of DOOM's own drawseg and vissprite
+ * arrays (ds_p - drawsegs, vissprite_p - vissprites) and how often they were
+ * full. On exit the histograms and their percentiles are written as a JSON
+ * report and summarised on stdout - typically after a -timedemo replay.
+ *
+ * Only gameplay frames are counted; the title screen and intermissions
+ * have no map to charge them to.
+ */
+
+#ifndef DOOM_TELEMETRY_H
+#define DOOM_TELEMETRY_H
+
+#include <stddef.h>
+
+#define TELEMETRY_MAX_MAPS     64
+#define TELEMETRY_BYTES_BUCKET 512    /* Payload histogram resolution */
+#define TELEMETRY_BYTES_MAX    (256 * 1024)  /* Larger frames share the last bucket */
+
+/**
+ * Start collecting. Registers an exit handler that writes the report.
+ *
+ * Args:
+ *   path: Report file (JSON)
+ *
+ * Returns: 0 on success, -1 if the report file can't be created
+ */
+int doom_telemetry_start(const char* path);
+
+/**
+ * Account one extracted gameplay frame (no-op unless started).
+ *
+ * Args:
+ *   walls: Wall records emitted
+ *   sprites: Sprite records emitted
+ *   bytes: Frame payload size (records + JSON)
+ *   drawsegs: Drawsegs DOOM used (ds_p - drawsegs)
+ *   vissprites: Vissprites DOOM used (vissprite_p - vissprites)
+ */
+void doom_telemetry_frame(int walls, int sprites, size_t bytes, int drawsegs, int vissprites);
+
+#endif /* DOOM_TELEMETRY_H */
@@ -0,0 +1,399 @@
+/**
+ * doom_texedges.c
+ *
+ * Per-texture edge line cache and per-wall projection.
+ */
+
+#include "doom_texedges.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "doomdata.h"
+#include "doomdef.h"
+#include "m_fixed.h"
+#include "r_data.h"
+#include "r_main.h"
+#include "r_sky.h"
+#include "r_state.h"
+#include "w_wad.h"
+#include "z_zone.h"
+
+/* One edge in texture space (texels). Vertical edges lie on the column
+ * boundary u1 == u2, horizontal ones on the row boundary v1 == v2. */
+typedef struct {
+    short u1, v1, u2, v2;
+} texedge_t;
+
+typedef struct {
+    int built;
+    int count;
+    texedge_t edges[TEXEDGE_PER_TEXTURE];
+    short length[TEXEDGE_PER_TEXTURE];
+} texedge_cache_t;
+
+/* One visible wall part being projected */
+typedef struct {
+    int wall;
+    double x1, x2;     /* Screen columns of the drawseg */
+    double s1, s2;     /* Projection scale at x1 / x2 */
+    double u1, u2;     /* Texture u at x1 / x2 (perspective-correct) */
+    double viewz;
+    double centery;
+    int emitted;
+} wall_proj_t;
+
+/* Declare external DOOM variables (defined in r_data.c) */
+extern int numtextures;
+extern int* texturewidthmask;
+
+static int g_contrast = TEXEDGE_DEFAULT_CONTRAST;
+static texedge_cache_t* g_cache = NULL;
+
+static int g_have_luma = 0;
+static byte g_luma[256];
+static byte g_texels[TEXEDGE_MAX_SIZE][TEXEDGE_MAX_SIZE];  /* [u][v] */
+
+void doom_texedges_init(int contrast) {
+    if (contrast >= 1 && contrast <= 255) {
+        g_contrast = contrast;
+    }
+}
+
+/**
+ * Helper: Palette index -> luminance from the first PLAYPAL palette.
+ */
+static void load_luma(void) {
+    const byte* palette = W_CacheLumpName("PLAYPAL", PU_CACHE);
+    for (int i = 0; i < 256; i++) {
+        const byte* rgb = &palette[i * 3];
+        g_luma[i] = (byte)((rgb[0] * 77 + rgb[1] * 150 + rgb[2] * 29) >> 8);
+    }
+    g_have_luma = 1;
+}
+
+/**
+ * Helper: Keep the TEXEDGE_PER_TEXTURE longest candidates, longest first.
+ */
+static void add_candidate(texedge_cache_t* c, int u1, int v1, int u2, int v2) {
+    int length = (u2 - u1) + (v2 - v1);
+    int slot = c->count;
+    while (slot > 0 && c->length[slot - 1] < length) {
+        slot--;
+    }
+    if (slot >= TEXEDGE_PER_TEXTURE) {
+        return;
+    }
+
+    int last = c->count < TEXEDGE_PER_TEXTURE ? c->count : TEXEDGE_PER_TEXTURE - 1;
+    memmove(&c->edges[slot + 1], &c->edges[slot], (last - slot) * sizeof(texedge_t));
+    memmove(&c->length[slot + 1], &c->length[slot], (last - slot) * sizeof(short));
+    c->edges[slot].u1 = (short)u1;
+    c->edges[slot].v1 = (short)v1;
+    c->edges[slot].u2 = (short)u2;
+    c->edges[slot].v2 = (short)v2;
+    c->length[slot] = (short)length;
+    if (c->count < TEXEDGE_PER_TEXTURE) {
+        c->count++;
+    }
+}
+
+/**
+ * Helper: Luminance step across the boundary before column u (vertical)
+ * or before row v (horizontal); 0 outside the texture.
+ */
+static int step_u(int u, int v, int width) {
+    if (u < 1 || u >= width) {
+        return 0;
+    }
+    return abs(g_texels[u][v] - g_texels[u - 1][v]);
+}
+
+static int step_v(int u, int v, int height) {
+    if (v < 1 || v >= height) {
+        return 0;
+    }
+    return abs(g_texels[u][v] - g_texels[u][v - 1]);
+}
+
+/**
+ * Helper: Find the edge lines of one texture. A texel boundary is on an
+ * edge when its step reaches the contrast and is a local maximum across
+ * neighbouring boundaries (a soft edge then gives one line, not two);
+ * runs of such boundaries of at least TEXEDGE_MIN_LENGTH become lines.
+ */
+static void build_texture(int texnum, texedge_cache_t* c) {
+    int width = texturewidthmask[texnum] + 1;
+    int height = textureheight[texnum] >> FRACBITS;
+    if (width > TEXEDGE_MAX_SIZE) width = TEXEDGE_MAX_SIZE;
+    if (height > TEXEDGE_MAX_SIZE) height = TEXEDGE_MAX_SIZE;
+
+    c->built = 1;
+    c->count = 0;
+    if (height < TEXEDGE_MIN_LENGTH) {
+        return;
+    }
+
+    for (int u = 0; u < width; u++) {
+        const byte* column = R_GetColumn(texnum, u);
+        for (int v = 0; v < height; v++) {
+            g_texels[u][v] = g_luma[column[v]];
+        }
+    }
+
+    /* Vertical edges: column boundaries, scanned down the rows */
+    for (int u = 1; u < width; u++) {
+        int start = -1;
+        for (int v = 0; v <= height; v++) {
+            int step = v < height ? step_u(u, v, width) : 0;
+            int edge = step >= g_contrast &&
+                       step >= step_u(u - 1, v, width) && step > step_u(u + 1, v, width);
+            if (edge && start < 0) {
+                start = v;
+            } else if (!edge && start >= 0) {
+                if (v - start >= TEXEDGE_MIN_LENGTH) {
+                    add_candidate(c, u, start, u, v);
+                }
+                start = -1;
+            }
+        }
+    }
+
+    /* Horizontal edges: row boundaries, scanned across the columns */
+    for (int v = 1; v < height; v++) {
+        int start = -1;
+        for (int u = 0; u <= width; u++) {
+            int step = u < width ? step_v(u, v, height) : 0;
+            int edge = step >= g_contrast &&
+                       step >= step_v(u, v - 1, height) && step > step_v(u, v + 1, height);
+            if (edge && start < 0) {
+                start = u;
+            } else if (!edge && start >= 0) {
+                if (u - start >= TEXEDGE_MIN_LENGTH) {
+                    add_candidate(c, start, v, u, v);
+                }
+                start = -1;
+            }
+        }
+    }
+}
+
+/**
+ * Helper: Cached edges of a texture, analysed on first use.
+ */
+static const texedge_cache_t* texture_edges(int texnum) {
+    if (g_cache == NULL) {
+        g_cache = calloc(numtextures, sizeof(*g_cache));
+        if (g_cache == NULL) {
+            return NULL;
+        }
+    }
+    if (!g_have_luma) {
+        load_luma();
+    }
+
+    texedge_cache_t* c = &g_cache[texnum];
+    if (!c->built) {
+        build_texture(texnum, c);
+    }
+    return c;
+}
+
+/**
+ * Helper: Texture u where screen column x's ray meets the seg (the seg's
+ * own offset plus distance from its first vertex, clamped to the seg).
+ */
+static double seg_u(const seg_t* seg, int x, double base) {
+    double angle = (angle_t)(viewangle + xtoviewangle[x]) * (2.0 * M_PI / 4294967296.0);
+    double dx = cos(angle);
+    double dy = sin(angle);
+
+    double ax = (double)seg->v1->x / FRACUNIT;
+    double ay = (double)seg->v1->y / FRACUNIT;
+    double ex = (double)seg->v2->x / FRACUNIT - ax;
+    double ey = (double)seg->v2->y / FRACUNIT - ay;
+    double px = (double)viewx / FRACUNIT - ax;
+    double py = (double)viewy / FRACUNIT - ay;
+
+    double denom = ex * dy - ey * dx;
+    double s = fabs(denom) > 1e-9 ? (px * dy - py * dx) / denom : 0.0;
+    if (s < 0.0) s = 0.0;
+    if (s > 1.0) s = 1.0;
+    return base + s * sqrt(ex * ex + ey * ey);
+}
+
+/**
+ * Helper: Interpolation parameter (0 at x1, 1 at x2) where the wall shows
+ * texture u. u * scale is linear in screen x, so this is exact.
+ */
+static double param_at(const wall_proj_t* p, double u) {
+    double a = p->s1 * (u - p->u1);
+    double b = p->s2 * (p->u2 - u);
+    return a + b != 0.0 ? a / (a + b) : 0.0;
+}
+
+/**
+ * Helper: Append one line, clipped to the view height.
+ */
+static void emit_line(wall_proj_t* p, double xa, double ya, double xb, double yb,
+                      texedge_set_t* out) {
+    double top = 0.0;
+    double bottom = viewheight - 1;
+    if ((ya < top && yb < top) || (ya > bottom && yb > bottom)) {
+        return;
+    }
+    if (out->line_count >= TEXEDGE_MAX_LINES || p->emitted >= TEXEDGE_PER_WALL) {
+        return;
+    }
+
+    /* Clip both ends to [top, bottom] along the line */
+    double ta = 0.0, tb = 1.0;
+    double dy = yb - ya;
+    if (dy != 0.0) {
+        double t_top = (top - ya) / dy;
+        double t_bottom = (bottom - ya) / dy;
+        double t_lo = t_top < t_bottom ? t_top : t_bottom;
+        double t_hi = t_top < t_bottom ? t_bottom : t_top;
+        if (t_lo > ta) ta = t_lo;
+        if (t_hi < tb) tb = t_hi;
+    }
+    if (ta >= tb) {
+        return;
+    }
+
+    short (*pt)[2] = &out->points[out->line_count * 2];
+    pt[0][0] = (short)lround(xa + (xb - xa) * ta);
+    pt[0][1] = (short)lround(ya + dy * ta);
+    pt[1][0] = (short)lround(xa + (xb - xa) * tb);
+    pt[1][1] = (short)lround(ya + dy * tb);
+    out->wall[out->line_count] = (short)p->wall;
+    out->line_count++;
+    p->emitted++;
+}
+
+/**
+ * Helper: Project the edges of one wall part.
+ *
+ * Args:
+ *   texnum: Texture of the part (before animation translation)
+ *   zlo, zhi: World heights the part covers
+ *   vtop: World height of texture row 0 (pegging and row offset applied)
+ */
+static void project_part(wall_proj_t* p, int texnum, double zlo, double zhi, double vtop,
+                         texedge_set_t* out) {
+    if (texnum <= 0 || zhi <= zlo) {
+        return;
+    }
+    texnum = texturetranslation[texnum];
+    const texedge_cache_t* c = texture_edges(texnum);
+    if (c == NULL || c->count == 0) {
+        return;
+    }
+
+    double tile_u = texturewidthmask[texnum] + 1;
+    double tile_v = textureheight[texnum] >> FRACBITS;
+    if (tile_v < 1.0) {
+        return;
+    }
+    double umin = p->u1 < p->u2 ? p->u1 : p->u2;
+    double umax = p->u1 < p->u2 ? p->u2 : p->u1;
+    double vmin = vtop - zhi;  /* Texture rows the part shows */
+    double vmax = vtop - zlo;
+
+    for (int i = 0; i < c->count && p->emitted < TEXEDGE_PER_WALL; i++) {
+        const texedge_t* e = &c->edges[i];
+
+        for (double m = floor((umin - e->u2) / tile_u); m * tile_u + e->u1 < umax; m++) {
+            double ua = e->u1 + m * tile_u;
+            double ub = e->u2 + m * tile_u;
+            if (ua < umin) ua = umin;
+            if (ub > umax) ub = umax;
+            if (ub < ua) {
+                continue;
+            }
+
+            double ta = param_at(p, ua), tb = param_at(p, ub);
+            double xa = p->x1 + (p->x2 - p->x1) * ta, xb = p->x1 + (p->x2 - p->x1) * tb;
+            double sa = p->s1 + (p->s2 - p->s1) * ta, sb = p->s1 + (p->s2 - p->s1) * tb;
+
+            for (double k = floor((vmin - e->v2) / tile_v); k * tile_v + e->v1 < vmax; k++) {
+                double va = e->v1 + k * tile_v;
+                double vb = e->v2 + k * tile_v;
+                if (e->u1 == e->u2) {
+                    if (va < vmin) va = vmin;
+                    if (vb > vmax) vb = vmax;
+                    if (vb <= va) {
+                        continue;
+                    }
+                } else if (va <= vmin || va >= vmax) {
+                    continue;  /* Rows on (or past) the part's border add nothing */
+                }
+
+                /* Screen y of texture row v at scale s */
+                double za = vtop - va - p->viewz;
+                double zb = vtop - vb - p->viewz;
+                emit_line(p, xa, p->centery - za * sa, xb, p->centery - zb * sb, out);
+            }
+        }
+    }
+}
+
+void doom_texedges_begin(texedge_set_t* out) {
+    out->line_count = 0;
+}
+
+void doom_texedges_wall(const drawseg_t* ds, int wall, texedge_set_t* out) {
+    const seg_t* seg = ds->curline;
+    if (seg == NULL || seg->sidedef == NULL || seg->linedef == NULL ||
+        seg->frontsector == NULL || ds->x2 <= ds->x1) {
+        return;
+    }
+
+    const side_t* side = seg->sidedef;
+    const sector_t* front = seg->frontsector;
+    const sector_t* back = seg->backsector;
+    int flags = seg->linedef->flags;
+
+    wall_proj_t p;
+    double base = (double)(seg->offset + side->textureoffset) / FRACUNIT;
+    p.wall = wall;
+    p.x1 = ds->x1;
+    p.x2 = ds->x2;
+    p.s1 = (double)ds->scale1 / FRACUNIT;
+    p.s2 = (double)ds->scale2 / FRACUNIT;
+    p.u1 = seg_u(seg, ds->x1, base);
+    p.u2 = seg_u(seg, ds->x2, base);
+    p.viewz = (double)viewz / FRACUNIT;
+    p.centery = (double)centeryfrac / FRACUNIT;
+    p.emitted = 0;
+    if (p.s1 <= 0.0 || p.s2 <= 0.0 || p.u1 == p.u2) {
+        return;
+    }
+
+    /* Same pegging rules as R_StoreWallRange() */
+    double floor_z = (double)front->floorheight / FRACUNIT;
+    double ceiling_z = (double)front->ceilingheight / FRACUNIT;
+    double row = (double)side->rowoffset / FRACUNIT;
+
+    if (back == NULL) {
+        double height = (double)(textureheight[side->midtexture] >> FRACBITS);
+        double vtop = (flags & ML_DONTPEGBOTTOM) ? floor_z + height : ceiling_z;
+        project_part(&p, side->midtexture, floor_z, ceiling_z, vtop + row, out);
+        return;
+    }
+
+    double back_floor = (double)back->floorheight / FRACUNIT;
+    double back_ceiling = (double)back->ceilingheight / FRACUNIT;
+
+    int sky = front->ceilingpic == skyflatnum && back->ceilingpic == skyflatnum;
+    if (!sky && back_ceiling < ceiling_z) {
+        double height = (double)(textureheight[side->toptexture] >> FRACBITS);
+        double vtop = (flags & ML_DONTPEGTOP) ? ceiling_z : back_ceiling + height;
+        project_part(&p, side->toptexture, back_ceiling, ceiling_z, vtop + row, out);
+    }
+    if (back_floor > floor_z) {
+        double vtop = (flags & ML_DONTPEGBOTTOM) ? ceiling_z : back_floor;
+        project_part(&p, side->bottomtexture, floor_z, back_floor, vtop + row, out);
+    }
+}
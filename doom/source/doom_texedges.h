@@ -0,0 +1,65 @@
+/**
+ * doom_texedges.h
+ *
+ * Texture edge lines projected onto the extracted walls.
+ *
+ * Walls are sent as bare quads, so doors, switches and computer panels look
+ * like any other wall on the board and the scope. Finding detail in the
+ * rendered pixels every frame would cost far too much. Instead each wall
+ * texture is analysed once, on first use: its columns (R_GetColumn(), the
+ * data DOOM draws from) are turned into luminance and every strong contrast
+ * boundary between adjacent columns or rows becomes an axis-aligned line in
+ * texture space; the longest few are kept per texture.
+ *
+ * Per frame, each visible wall part (one-sided middle, upper or lower) maps
+ * its cached lines through the seg's texture offsets, the sidedef/pegging
+ * vertical origin and the scale1..scale2 interpolation DOOM itself draws
+ * with (texture u is perspective-correct, scale is linear in screen x).
+ * That is one table lookup and a few multiplies per line.
+ */
+
+#ifndef DOOM_TEXEDGES_H
+#define DOOM_TEXEDGES_H
+
+#include "r_defs.h"
+
+/* Minimum luminance step (0-255) for a texel boundary to count as an edge */
+#define TEXEDGE_DEFAULT_CONTRAST 48
+
+#define TEXEDGE_PER_TEXTURE  12    /* Longest edges kept per texture */
+#define TEXEDGE_MIN_LENGTH   4     /* Texels */
+#define TEXEDGE_MAX_SIZE     256   /* Texture area analysed (u and v) */
+#define TEXEDGE_PER_WALL     48    /* Lines per wall, tiling included */
+#define TEXEDGE_MAX_LINES    2048  /* Lines per frame */
+
+typedef struct {
+    int line_count;
+    short wall[TEXEDGE_MAX_LINES];               /* Gathered wall index */
+    short points[TEXEDGE_MAX_LINES * 2][2];      /* Two screen points per line */
+} texedge_set_t;
+
+/**
+ * Set the contrast threshold (before the first frame).
+ *
+ * Args:
+ *   contrast: Minimum luminance step, 1-255
+ */
+void doom_texedges_init(int contrast);
+
+/**
+ * Empty the line set for a new frame.
+ */
+void doom_texedges_begin(texedge_set_t* out);
+
+/**
+ * Project the edge lines of one drawseg's textures. Must be called after
+ * R_RenderPlayerView(), with the view that rendered it.
+ *
+ * Args:
+ *   ds: The drawseg (its curline, x1..x2 and scale1/scale2)
+ *   wall: Index of the wall record the lines belong to
+ *   out: Output - lines are appended in view coordinates
+ */
+void doom_texedges_wall(const drawseg_t* ds, int wall, texedge_set_t* out);
+
+#endif /* DOOM_TEXEDGES_H */
@@ -0,0 +1,149 @@
+/**
+ * doom_top.c
+ *
+ * top-style monitor for the stats page DOOM publishes with -statsshm.
+ *
+ * Maps the segment read-only and prints a snapshot every interval. Reading
+ * takes no lock and writes nothing, so it can't slow the game loop down; a
+ * read that overlaps an update is simply retried.
+ *
+ * Usage:
+ *   doom_top [-n /name] [-i interval_ms] [-1]
+ *     -n  Segment name (default /kidoom_stats)
+ *     -i  Refresh interval in milliseconds (default 1000)
+ *     -1  Print one snapshot and exit (no screen clearing)
+ *
+ * Build (standalone, no engine sources needed):
+ *   cc -O2 -o doom_top doom_top.c
+ */
+
+#include "doom_stats.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * Helper: Map the stats segment read-only.
+ *
+ * Returns: Page, or NULL if DOOM isn't publishing
+ */
+static const stats_page_t* map_page(const char* name) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    void* page = mmap(NULL, sizeof(stats_page_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (page == MAP_FAILED) {
+        return NULL;
+    }
+
+    const stats_page_t* stats = (const stats_page_t*)page;
+    if (__atomic_load_n(&stats->magic, __ATOMIC_ACQUIRE) != STATS_MAGIC ||
+        stats->version != STATS_VERSION || stats->size != sizeof(stats_page_t)) {
+        fprintf(stderr, "doom_top: %s has an unknown layout (version %u)\n", name, stats->version);
+        munmap(page, sizeof(stats_page_t));
+        return NULL;
+    }
+    return stats;
+}
+
+/**
+ * Helper: Print one snapshot. prev is the previous snapshot (rates are
+ * computed over the interval between the two) or NULL.
+ */
+static void print_snapshot(const char* name, const stats_page_t* page,
+                           const stats_values_t* s, const stats_values_t* prev) {
+    double up_s = (s->time_us - s->start_us) / 1e6;
+    double fps = 0.0, avg_fps = 0.0, bytes_rate = 0.0;
+
+    if (prev != NULL && s->time_us > prev->time_us) {
+        double dt = (s->time_us - prev->time_us) / 1e6;
+        fps = (s->frame - prev->frame) / dt;
+        bytes_rate = (s->bytes_total - prev->bytes_total) / dt;
+    }
+    if (up_s > 0) {
+        avg_fps = s->frame / up_s;
+    }
+
+    printf("KiDoom %s  pid %d  up %.1fs\n", name, page->pid, up_s);
+    printf("Frame   %-8llu tic %-8llu FPS %5.1f (avg %.1f)\n",
+           (unsigned long long)s->frame, (unsigned long long)s->tic, fps, avg_fps);
+    printf("Frames  sent %-8llu idle skipped %-8llu late %llu\n",
+           (unsigned long long)s->frames_sent, (unsigned long long)s->idle_skipped,
+           (unsigned long long)s->late_frames);
+    printf("Phases  game %.2fms  extract %.2fms  send %.2fms  present %.2fms  = %.2fms (max %.2fms)\n",
+           s->game_us / 1000.0, s->extract_us / 1000.0, s->send_us / 1000.0,
+           s->present_us / 1000.0, s->work_us / 1000.0, s->work_max_us / 1000.0);
+    printf("Socket  %.1f KB/frame  %.1f KB/s  writev/frame %.2f\n",
+           s->frame_bytes / 1024.0, bytes_rate / 1024.0,
+           s->frames_sent ? (double)s->write_calls / s->frames_sent : 0.0);
+    printf("Queues  pending messages %llu  export %llu\n",
+           (unsigned long long)s->pending_messages, (unsigned long long)s->export_queue);
+    printf("Scene   walls %llu  sprites %llu  view %llux%llu\n",
+           (unsigned long long)s->walls, (unsigned long long)s->sprites,
+           (unsigned long long)s->view_width, (unsigned long long)s->view_height);
+    printf("Pacing  consumer queue %.2fms  present %.2fms  delay %.2fms\n",
+           s->queue_us / 1000.0, s->consumer_us / 1000.0, s->pacing_us / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    const char* name = STATS_SHM_DEFAULT;
+    int interval_ms = 1000;
+    int once = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_ms = atoi(argv[++i]);
+            if (interval_ms < 10) interval_ms = 10;
+        } else if (strcmp(argv[i], "-1") == 0) {
+            once = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [-n /name] [-i interval_ms] [-1]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const stats_page_t* page = map_page(name);
+    if (page == NULL) {
+        fprintf(stderr, "doom_top: no stats page %s (start DOOM with -statsshm)\n", name);
+        return 1;
+    }
+
+    stats_values_t current, previous = {0};
+    int have_previous = 0;
+
+    for (;;) {
+        if (doom_stats_read(page, &current) < 0) {
+            usleep(1000);
+            continue;
+        }
+
+        if (!once) {
+            printf("\033[H\033[J");  /* Home + clear */
+        }
+        print_snapshot(name, page, &current, have_previous ? &previous : NULL);
+
+        if (kill(page->pid, 0) < 0 && errno == ESRCH) {
+            printf("\n(DOOM process %d has exited)\n", page->pid);
+            return 0;
+        }
+        if (once) {
+            return 0;
+        }
+        fflush(stdout);
+
+        previous = current;
+        have_previous = 1;
+        usleep(interval_ms * 1000);
+    }
+}
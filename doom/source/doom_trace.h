@@ -0,0 +1,56 @@
+/**
+ * doom_trace.h
+ *
+ * USDT (user-level statically defined) tracepoints, provider "kidoom".
+ *
+ * Each probe compiles to a single nop plus an ELF note describing where its
+ * arguments live; nothing runs unless bpftrace/perf attaches to it, so the
+ * probes stay in production builds. Scripts for latency distributions are in
+ * bpftrace/. List the probes in a binary with:
+ *   bpftrace -l 'usdt:./doomgeneric_kicad:kidoom:*'
+ *
+ * Probes (arguments in order):
+ *   frame__begin        frame, tic
+ *   frame__end          frame, payload bytes (0 = not sent)
+ *   extract__begin      frame
+ *   extract__end        frame, walls, sprites, payload bytes
+ *   send__start         msg type, payload bytes, queued control messages
+ *   send__complete      msg type, bytes written, result (0 / -1)
+ *   key__event          pressed, DOOM key code
+ *   screenshot__begin   frame
+ *   screenshot__end     frame, result (0 / -1)
+ *
+ * Without <sys/sdt.h> (systemtap-sdt-dev) or with -DKIDOOM_NO_TRACE the
+ * macros expand to nothing.
+ */
+
+#ifndef DOOM_TRACE_H
+#define DOOM_TRACE_H
+
+#if !defined(KIDOOM_NO_TRACE) && defined(__linux__) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define KIDOOM_TRACE_ENABLED 1
+#endif
+#endif
+
+#ifdef KIDOOM_TRACE_ENABLED
+
+#include <sys/sdt.h>
+
+#define DOOM_TRACE1(name, a)          DTRACE_PROBE1(kidoom, name, a)
+#define DOOM_TRACE2(name, a, b)       DTRACE_PROBE2(kidoom, name, a, b)
+#define DOOM_TRACE3(name, a, b, c)    DTRACE_PROBE3(kidoom, name, a, b, c)
+#define DOOM_TRACE4(name, a, b, c, d) DTRACE_PROBE4(kidoom, name, a, b, c, d)
+
+#else
+
+/* Arguments are not evaluated, only marked as used */
+#define DOOM_TRACE1(name, a)          do { (void)sizeof(a); } while (0)
+#define DOOM_TRACE2(name, a, b)       do { (void)sizeof(a); (void)sizeof(b); } while (0)
+#define DOOM_TRACE3(name, a, b, c)    do { (void)sizeof(a); (void)sizeof(b); (void)sizeof(c); } while (0)
+#define DOOM_TRACE4(name, a, b, c, d) \
+    do { (void)sizeof(a); (void)sizeof(b); (void)sizeof(c); (void)sizeof(d); } while (0)
+
+#endif
+
+#endif /* DOOM_TRACE_H */
@@ -14,6 +14,7 @@
 #include <math.h>
 
 #include "doom_vectors.h"
+#include "doom_json.h"
 
 /* Maximum vectors to track per frame */
 #define MAX_WALLS 500
@@ -80,46 +81,64 @@ void DV_AddEntity(int x, int y, int type, int angle, int distance) {
  */
 char* DV_GenerateJSON(size_t* out_len) {
     static char json_buf[131072];  /* 128KB buffer */
-    int offset = 0;
+    json_writer_t w;
+    doom_json_init(&w, json_buf, sizeof(json_buf));
 
     /* Start JSON object */
-    offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                      "{\"frame\":%d,\"walls\":[", g_frame_number);
+    JSON_LITERAL(&w, "{\"frame\":");
+    doom_json_int(&w, g_frame_number);
+    JSON_LITERAL(&w, ",\"walls\":[");
 
     /* Add walls */
     for (int i = 0; i < g_wall_count; i++) {
         wall_segment_t* wall = &g_walls[i];
 
         if (i > 0) {
-            offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, ",");
+            doom_json_char(&w, ',');
         }
 
-        offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                          "{\"x1\":%d,\"y1\":%d,\"x2\":%d,\"y2\":%d,\"distance\":%d,\"height\":%d}",
-                          wall->x1, wall->y1, wall->x2, wall->y2,
-                          wall->distance, wall->height);
+        JSON_LITERAL(&w, "{\"x1\":");
+        doom_json_int(&w, wall->x1);
+        JSON_LITERAL(&w, ",\"y1\":");
+        doom_json_int(&w, wall->y1);
+        JSON_LITERAL(&w, ",\"x2\":");
+        doom_json_int(&w, wall->x2);
+        JSON_LITERAL(&w, ",\"y2\":");
+        doom_json_int(&w, wall->y2);
+        JSON_LITERAL(&w, ",\"distance\":");
+        doom_json_int(&w, wall->distance);
+        JSON_LITERAL(&w, ",\"height\":");
+        doom_json_int(&w, wall->height);
+        doom_json_char(&w, '}');
     }
 
-    offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, "],\"entities\":[");
+    JSON_LITERAL(&w, "],\"entities\":[");
 
     /* Add entities */
     for (int i = 0; i < g_entity_count; i++) {
         entity_t* entity = &g_entities[i];
 
         if (i > 0) {
-            offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, ",");
+            doom_json_char(&w, ',');
         }
 
-        offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                          "{\"x\":%d,\"y\":%d,\"type\":%d,\"angle\":%d,\"distance\":%d}",
-                          entity->x, entity->y, entity->type,
-                          entity->angle, entity->distance);
+        JSON_LITERAL(&w, "{\"x\":");
+        doom_json_int(&w, entity->x);
+        JSON_LITERAL(&w, ",\"y\":");
+        doom_json_int(&w, entity->y);
+        JSON_LITERAL(&w, ",\"type\":");
+        doom_json_int(&w, entity->type);
+        JSON_LITERAL(&w, ",\"angle\":");
+        doom_json_int(&w, entity->angle);
+        JSON_LITERAL(&w, ",\"distance\":");
+        doom_json_int(&w, entity->distance);
+        doom_json_char(&w, '}');
     }
 
     /* Close JSON */
-    offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, "]}");
+    JSON_LITERAL(&w, "]}");
 
-    *out_len = offset;
+    *out_len = w.len;
     return json_buf;
 }
 
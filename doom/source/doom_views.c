@@ -0,0 +1,154 @@
+/**
+ * doom_views.c
+ *
+ * Extra viewpoints: camera substitution around R_RenderPlayerView().
+ */
+
+#include "doom_views.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "doomdef.h"
+#include "doomstat.h"
+#include "d_player.h"
+#include "i_video.h"
+#include "m_argv.h"
+#include "m_fixed.h"
+#include "r_main.h"
+#include "tables.h"
+
+extern player_t players[MAXPLAYERS];
+extern int consoleplayer;
+
+static view_spec_t g_views[VIEWS_MAX];
+static int g_view_count = 0;
+
+/* Player view (status bar, HUD, border) while extra views draw over it */
+static byte g_screen_backup[SCREENWIDTH * SCREENHEIGHT];
+
+/**
+ * Helper: Parse one -view argument into spec.
+ *
+ * Returns: 0 on success, -1 if malformed
+ */
+static int parse_spec(const char* arg, int index, view_spec_t* spec) {
+    char body[VIEWS_PATH_MAX + 64];
+    snprintf(body, sizeof(body), "%s", arg);
+
+    memset(spec, 0, sizeof(*spec));
+    spec->height = VIEWS_DEFAULT_HEIGHT;
+    snprintf(spec->path, sizeof(spec->path), "/tmp/kicad_doom_view%d.sock", index + 1);
+
+    char* at = strchr(body, '@');
+    if (at != NULL) {
+        *at = '\0';
+        if (at[1] == '\0') {
+            return -1;
+        }
+        snprintf(spec->path, sizeof(spec->path), "%s", at + 1);
+    }
+
+    if (strcmp(body, "rear") == 0) {
+        spec->kind = VIEW_REAR;
+        return 0;
+    }
+
+    if (strncmp(body, "cam:", 4) == 0) {
+        int n = sscanf(body + 4, "%d,%d,%d,%d", &spec->x, &spec->y, &spec->angle, &spec->height);
+        if (n < 3) {
+            return -1;
+        }
+        spec->kind = VIEW_CAMERA;
+        return 0;
+    }
+
+    return -1;
+}
+
+int doom_views_parse(void) {
+    g_view_count = 0;
+
+    for (int i = 1; i < myargc - 1; i++) {
+        if (strcmp(myargv[i], "-view") != 0) {
+            continue;
+        }
+        if (g_view_count >= VIEWS_MAX) {
+            fprintf(stderr, "Warning: more than %d -view options, ignoring the rest\n", VIEWS_MAX);
+            break;
+        }
+        if (parse_spec(myargv[i + 1], g_view_count, &g_views[g_view_count]) < 0) {
+            fprintf(stderr, "Error: bad -view '%s' (expected rear or cam:x,y,angle[,height], "
+                    "optionally @path)\n", myargv[i + 1]);
+            return -1;
+        }
+        g_view_count++;
+        i++;
+    }
+
+    return g_view_count;
+}
+
+int doom_views_count(void) {
+    return g_view_count;
+}
+
+const view_spec_t* doom_views_get(int view) {
+    return &g_views[view];
+}
+
+void doom_views_begin(void) {
+    memcpy(g_screen_backup, I_VideoBuffer, sizeof(g_screen_backup));
+}
+
+void doom_views_render(int view) {
+    const view_spec_t* spec = &g_views[view];
+    player_t* player = &players[consoleplayer];
+
+    if (player->mo == NULL) {
+        return;
+    }
+
+    /* R_SetupFrame() reads position and angle from player->mo and the eye
+     * height from player->viewz: point both at the camera for one render */
+    static mobj_t camera;
+    mobj_t* body = player->mo;
+    fixed_t viewz = player->viewz;
+    pspdef_t psprites[NUMPSPRITES];
+
+    camera = *body;
+    if (spec->kind == VIEW_REAR) {
+        camera.angle = body->angle + ANG180;
+    } else {
+        int degrees = ((spec->angle % 360) + 360) % 360;
+        camera.x = spec->x << FRACBITS;
+        camera.y = spec->y << FRACBITS;
+        camera.angle = (angle_t)(((uint64_t)degrees << 32) / 360);
+        camera.subsector = R_PointInSubsector(camera.x, camera.y);
+
+        sector_t* sector = camera.subsector->sector;
+        fixed_t z = sector->floorheight + (spec->height << FRACBITS);
+        if (z > sector->ceilingheight - 4 * FRACUNIT) {
+            z = sector->ceilingheight - 4 * FRACUNIT;
+        }
+        player->viewz = z;
+    }
+
+    /* No weapon overlay from somewhere else */
+    memcpy(psprites, player->psprites, sizeof(psprites));
+    for (int i = 0; i < NUMPSPRITES; i++) {
+        player->psprites[i].state = NULL;
+    }
+
+    player->mo = &camera;
+    R_RenderPlayerView(player);
+
+    player->mo = body;
+    player->viewz = viewz;
+    memcpy(player->psprites, psprites, sizeof(psprites));
+}
+
+void doom_views_end(void) {
+    memcpy(I_VideoBuffer, g_screen_backup, sizeof(g_screen_backup));
+}
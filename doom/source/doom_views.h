@@ -0,0 +1,81 @@
+/**
+ * doom_views.h
+ *
+ * Extra viewpoints rendered every tic (-view), for multi-board displays.
+ *
+ * After the player's view has been drawn and extracted, each extra view
+ * re-runs R_RenderPlayerView() from a different camera and is extracted
+ * into its own frame for its own subscriber. A view is either:
+ *
+ *   rear                      The player's position, looking backwards
+ *   cam:x,y,angle[,height]    A fixed camera: map units, degrees
+ *                             (0 = east, 90 = north) and eye height above
+ *                             the floor (default VIEWS_DEFAULT_HEIGHT)
+ *
+ * optionally followed by @<socket path> (default /tmp/kicad_doom_view<N>.sock,
+ * N counting from 1). Give -view once per viewpoint.
+ *
+ * Extra views don't show the weapon, and the status bar/HUD in the screen
+ * buffer is restored afterwards, so the SDL window and screenshots keep
+ * showing the player's view.
+ */
+
+#ifndef DOOM_VIEWS_H
+#define DOOM_VIEWS_H
+
+#include "doom_socket.h"
+
+#define VIEWS_MAX             SOCKET_VIEWS_MAX
+#define VIEWS_DEFAULT_HEIGHT  41  /* Player eye height (VIEWHEIGHT) */
+#define VIEWS_PATH_MAX        108 /* sun_path */
+
+typedef enum {
+    VIEW_REAR,
+    VIEW_CAMERA
+} view_kind_t;
+
+typedef struct {
+    view_kind_t kind;
+    int x, y;         /* Camera position (map units) */
+    int angle;        /* Camera angle (degrees) */
+    int height;       /* Eye height above the floor (map units) */
+    char path[VIEWS_PATH_MAX];
+} view_spec_t;
+
+/**
+ * Parse every -view option on the command line.
+ *
+ * Returns: Number of views, or -1 if a spec is malformed
+ */
+int doom_views_parse(void);
+
+/**
+ * Number of parsed views.
+ */
+int doom_views_count(void);
+
+/**
+ * Parsed view (0-based).
+ */
+const view_spec_t* doom_views_get(int view);
+
+/**
+ * Back up the screen buffer before rendering extra views.
+ */
+void doom_views_begin(void);
+
+/**
+ * Render one extra view into the renderer state (drawsegs, vissprites,
+ * visplanes, screen buffer), ready for extraction. Only valid in a level.
+ *
+ * Args:
+ *   view: View index (0-based)
+ */
+void doom_views_render(int view);
+
+/**
+ * Restore the screen buffer saved by doom_views_begin().
+ */
+void doom_views_end(void);
+
+#endif /* DOOM_VIEWS_H */
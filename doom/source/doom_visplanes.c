@@ -0,0 +1,122 @@
+/**
+ * doom_visplanes.c
+ *
+ * Visplane floor/ceiling extraction as merged span polygons.
+ */
+
+#include "doom_visplanes.h"
+#include "doom_skyline.h"
+
+/* Import DOOM's internal rendering structures */
+#include "r_defs.h"
+#include "r_state.h"
+#include "r_sky.h"
+#include "m_fixed.h"
+
+/* top[] value DOOM uses for columns a visplane doesn't cover */
+#define VISPLANE_UNUSED 0xff
+
+/* Declare external DOOM variables (defined in r_plane.c) */
+extern visplane_t visplanes[];
+extern visplane_t* lastvisplane;
+
+extern int viewwidth;
+extern fixed_t viewz;
+extern int skyflatnum;
+
+/* Scratch edges for the run being merged */
+static short g_top[SCREENWIDTH];
+static short g_bottom[SCREENWIDTH];
+static short g_bottom_points[SCREENWIDTH][2];
+
+/**
+ * Helper: Check whether column x of the plane holds a visible span.
+ */
+static int column_used(const visplane_t* pl, int x) {
+    return pl->top[x] != VISPLANE_UNUSED && pl->top[x] <= pl->bottom[x];
+}
+
+/**
+ * Helper: Emit one polygon for columns [x0, x1] of the plane.
+ */
+static void emit_run(const visplane_t* pl, int x0, int x1, int tolerance, visplane_set_t* out) {
+    if (out->polygon_count >= VISPLANE_MAX_POLYGONS) {
+        return;
+    }
+
+    for (int x = x0; x <= x1; x++) {
+        g_top[x] = pl->top[x];
+        g_bottom[x] = pl->bottom[x];
+    }
+
+    visplane_polygon_t* poly = &out->polygons[out->polygon_count];
+    poly->first_point = out->point_count;
+
+    /* Top edge, left to right */
+    int room = VISPLANE_MAX_POINTS - out->point_count;
+    int top_count = doom_skyline_simplify(g_top, x0, x1, tolerance,
+                                          &out->points[out->point_count], room);
+
+    /* Bottom edge, appended right to left to close the outline */
+    int bottom_count = doom_skyline_simplify(g_bottom, x0, x1, tolerance,
+                                             g_bottom_points, SCREENWIDTH);
+    if (top_count + bottom_count > room) {
+        return;  /* Out of point storage - drop the polygon */
+    }
+
+    short (*dest)[2] = &out->points[out->point_count + top_count];
+    for (int i = 0; i < bottom_count; i++) {
+        dest[i][0] = g_bottom_points[bottom_count - 1 - i][0];
+        dest[i][1] = g_bottom_points[bottom_count - 1 - i][1];
+    }
+
+    poly->point_count = top_count + bottom_count;
+    out->point_count += poly->point_count;
+
+    if (pl->picnum == skyflatnum) {
+        poly->kind = VISPLANE_SKY;
+    } else if (pl->height > viewz) {
+        poly->kind = VISPLANE_CEILING;
+    } else {
+        poly->kind = VISPLANE_FLOOR;
+    }
+    poly->height = pl->height >> FRACBITS;
+    poly->lightlevel = pl->lightlevel;
+    poly->picnum = pl->picnum;
+
+    out->polygon_count++;
+}
+
+int doom_visplanes_build(int tolerance, visplane_set_t* out) {
+    out->polygon_count = 0;
+    out->point_count = 0;
+
+    if (tolerance < 0) tolerance = 0;
+
+    for (visplane_t* pl = visplanes; pl < lastvisplane; pl++) {
+        if (pl->minx > pl->maxx) {
+            continue;  /* Plane was allocated but never marked */
+        }
+
+        int minx = pl->minx < 0 ? 0 : pl->minx;
+        int maxx = pl->maxx >= viewwidth ? viewwidth - 1 : pl->maxx;
+
+        /* Run-length merge adjacent columns into polygons */
+        int x = minx;
+        while (x <= maxx) {
+            if (!column_used(pl, x)) {
+                x++;
+                continue;
+            }
+
+            int start = x;
+            while (x + 1 <= maxx && column_used(pl, x + 1)) {
+                x++;
+            }
+            emit_run(pl, start, x, tolerance, out);
+            x++;
+        }
+    }
+
+    return out->polygon_count;
+}
@@ -0,0 +1,58 @@
+/**
+ * doom_visplanes.h
+ *
+ * Floor/ceiling extraction from DOOM's visplanes.
+ *
+ * Each visplane stores a top[] / bottom[] row per screen column. Adjacent
+ * columns are run-length merged into outline polygons (top edge left to
+ * right, then bottom edge right to left), with both edges compressed by the
+ * skyline simplifier. A floor or ceiling becomes a few polygon records per
+ * plane instead of per-column data.
+ */
+
+#ifndef DOOM_VISPLANES_H
+#define DOOM_VISPLANES_H
+
+#include "doomdef.h"
+
+/* Default maximum vertical error (pixels) of polygon edges */
+#define VISPLANE_DEFAULT_TOLERANCE 2
+
+#define VISPLANE_MAX_POLYGONS 512
+#define VISPLANE_MAX_POINTS   8192
+
+/* Plane kinds (relative to the player's eye level) */
+#define VISPLANE_FLOOR   0
+#define VISPLANE_CEILING 1
+#define VISPLANE_SKY     2
+
+typedef struct {
+    int kind;          /* VISPLANE_FLOOR / CEILING / SKY */
+    int height;        /* World height in map units */
+    int lightlevel;    /* Sector light level (0-255) */
+    int picnum;        /* Flat number */
+    int first_point;   /* Index into visplane_set_t.points */
+    int point_count;
+} visplane_polygon_t;
+
+typedef struct {
+    int polygon_count;
+    visplane_polygon_t polygons[VISPLANE_MAX_POLYGONS];
+
+    int point_count;
+    short points[VISPLANE_MAX_POINTS][2];
+} visplane_set_t;
+
+/**
+ * Build merged outline polygons for every visplane of the frame that was
+ * just rendered. Must be called after R_RenderPlayerView().
+ *
+ * Args:
+ *   tolerance: Maximum vertical deviation of polygon edges in pixels
+ *   out: Output - polygons and their vertices
+ *
+ * Returns: Number of polygons written
+ */
+int doom_visplanes_build(int tolerance, visplane_set_t* out);
+
+#endif /* DOOM_VISPLANES_H */
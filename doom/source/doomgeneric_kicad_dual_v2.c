@@ -7,7 +7,34 @@
 #include "doomgeneric.h"
 #include "doomkeys.h"
 #include "doom_socket.h"
-
+#include "doom_assets.h"
+#include "doom_cache.h"
+#include "doom_clock.h"
+#include "doom_motion.h"
+#include "doom_depth.h"
+#include "doom_dynres.h"
+#include "doom_session.h"
+#include "doom_frame.h"
+#include "doom_export.h"
+#include "doom_golden.h"
+#include "doom_idle.h"
+#include "doom_input.h"
+#include "doom_json.h"
+#include "doom_pacing.h"
+#include "doom_prefetch.h"
+#include "doom_raster.h"
+#include "doom_records.h"
+#include "doom_sched.h"
+#include "doom_skyline.h"
+#include "doom_stats.h"
+#include "doom_telemetry.h"
+#include "doom_texedges.h"
+#include "doom_trace.h"
+#include "doom_views.h"
+#include "doom_visplanes.h"
+#include "m_argv.h"
+
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,6 +50,8 @@
 #include "r_plane.h"
 #include "p_pspr.h"
 #include "doomstat.h"
+#include "g_game.h"
+#include "i_system.h"
 #include "m_fixed.h"
 
 /* Declare external DOOM variables for vector extraction */
@@ -38,6 +67,13 @@ extern player_t players[MAXPLAYERS];
 extern int consoleplayer;
 extern fixed_t centeryfrac;
 extern fixed_t viewz;  /* Player eye-level Z coordinate */
+extern fixed_t viewx;
+extern fixed_t viewy;
+extern angle_t viewangle;
+extern int gametic;
+extern boolean demorecording;
+extern int vanilla_demo_limit;  /* g_game.c, config variable */
+extern boolean automapactive;
 
 /* SDL state */
 SDL_Window* window = NULL;
@@ -48,8 +84,81 @@ SDL_Texture* texture = NULL;
 static uint32_t g_start_time_ms = 0;
 static int g_frame_count = 0;
 
-/* Keyboard queue */
-#define KEYQUEUE_SIZE 16
+/* Headless mode (-headless): no SDL window, no socket - extraction only */
+static int g_headless = 0;
+
+/* Offline export sink (-export <dir>) */
+static int g_export = 0;
+
+/* Golden-hash oracle (-golden / -goldenwrite <file>) */
+static int g_golden = 0;
+
+/* Scheduling controls were given - print wake latency with the stats */
+static int g_sched_stats = 0;
+
+/* Dynamic resolution (-dynres <ms>): work time since the last frame ended */
+static int g_dynres = 0;
+static uint64_t g_frame_end_us = 0;
+static uint64_t g_slept_us = 0;
+
+/* Idle-frame suppression (-skipidle): signature of the last frame sent */
+static int g_skip_idle = 0;
+static int g_have_signature = 0;
+static uint64_t g_last_signature = 0;
+static uint64_t g_last_send_us = 0;
+static int g_idle_frames = 0;
+
+/* Live stats page (-statsshm [/name]): this frame's counters and phase times */
+static int g_stats_shm = 0;
+static stats_values_t g_live;
+
+/* Fast start (-loadgame): nothing is extracted before the first gameplay frame */
+static int g_fast_start = 0;
+static int g_first_frame_sent = 0;
+
+/* Game state of the previous frame (level transitions) */
+static gamestate_t g_last_gamestate = GS_DEMOSCREEN;
+static uint64_t g_process_start_us = 0;
+
+/* Set from SIGTERM/SIGINT, handled on the main loop */
+static volatile sig_atomic_t g_quit_requested = 0;
+
+/* Skyline output mode (-skyline): two outline polylines replace wall quads */
+static int g_skyline_mode = 0;
+static int g_skyline_tolerance = SKYLINE_DEFAULT_TOLERANCE;
+static skyline_polyline_t g_skyline_top;
+static skyline_polyline_t g_skyline_bottom;
+
+/* Visplane output (-planes): real floor/ceiling regions as polygons */
+static int g_planes_mode = 0;
+static int g_planes_tolerance = VISPLANE_DEFAULT_TOLERANCE;
+static visplane_set_t g_planes;
+
+/* Texture edge lines on the walls (-texedges) */
+static int g_texedges_mode = 0;
+static texedge_set_t g_texedges;
+static short g_wall_slot[MAXDRAWSEGS];  /* Gathered wall -> index in "walls" */
+
+/* Extra viewpoints (-view), each sent to its own subscriber */
+static int g_view_count = 0;
+
+/* Gathered frame primitives */
+static doom_frame_t g_frame;
+
+/* Binary frame records (the consumer announced our record schema): walls
+ * and entities are packed here instead of going into the JSON */
+static int g_records = 0;
+static uint8_t g_records_buf[RECORD_FRAME_SIZE + MAXDRAWSEGS * RECORD_WALL_SIZE +
+                             MAXVISSPRITES * RECORD_ENTITY_SIZE];
+static size_t g_records_len = 0;
+
+/* Depth order (-depthorder far|near): -1 = emission order */
+static int g_depth_order = -1;
+static short g_depth_keys[MAXDRAWSEGS + MAXVISSPRITES];
+static short g_order[MAXDRAWSEGS + MAXVISSPRITES];
+
+/* Keyboard queue (room for a burst of snapshot changes between two tics) */
+#define KEYQUEUE_SIZE 64
 static unsigned short s_KeyQueue[KEYQUEUE_SIZE];
 static unsigned int s_KeyQueueWriteIndex = 0;
 static unsigned int s_KeyQueueReadIndex = 0;
@@ -93,19 +202,45 @@ static unsigned char convertToDoomKey(unsigned int key){
     }
 }
 
-static void addKeyToQueue(int pressed, unsigned int keyCode){
-  unsigned char key = convertToDoomKey(keyCode);
+/* Input sources are only drained while there is room, so nothing is dropped */
+static int keyQueueFull(void){
+  return (s_KeyQueueWriteIndex + 1) % KEYQUEUE_SIZE == s_KeyQueueReadIndex;
+}
+
+static void addDoomKeyToQueue(int pressed, unsigned char key){
   unsigned short keyData = (pressed << 8) | key;
   s_KeyQueue[s_KeyQueueWriteIndex] = keyData;
   s_KeyQueueWriteIndex++;
   s_KeyQueueWriteIndex %= KEYQUEUE_SIZE;
 }
 
+static void addKeyToQueue(int pressed, unsigned int keyCode){
+  unsigned char key = convertToDoomKey(keyCode);
+  /* Held apart from the consumer's keys: its snapshots can't release it */
+  if (doom_input_local_key(pressed, key)) {
+    addDoomKeyToQueue(pressed, key);
+  }
+}
+
+/* Write a -record demo before exiting. G_CheckDemoStatus() saves the lump
+ * and exits through I_Error, so this only returns when not recording. */
+static void finishDemoRecording(void){
+  if (demorecording){
+    G_CheckDemoStatus();
+  }
+}
+
+static void onQuitSignal(int sig){
+  (void)sig;
+  g_quit_requested = 1;
+}
+
 static void handleKeyInput(){
   SDL_Event e;
-  while (SDL_PollEvent(&e)){
+  while (!keyQueueFull() && SDL_PollEvent(&e)){
     if (e.type == SDL_QUIT){
       puts("Quit requested");
+      finishDemoRecording();
       atexit(SDL_Quit);
       exit(1);
     }
@@ -115,19 +250,113 @@ static void handleKeyInput(){
       addKeyToQueue(0, e.key.keysym.sym);
     }
   }
+
+  /* Keys from the consumer (input snapshots or single events) */
+  int pressed;
+  unsigned char key;
+  int ret = 0;
+  while (!keyQueueFull() && (ret = doom_socket_recv_key(&pressed, &key)) > 0) {
+    addDoomKeyToQueue(pressed, key);
+  }
+  if (ret < 0) {
+    /* SHUTDOWN from the consumer, or the connection is gone */
+    puts("Socket closed, quitting");
+    finishDemoRecording();
+    I_Quit();
+  }
 }
 
-/* Vector extraction function (from our working code) */
-static char* extract_vectors_to_json(size_t* out_len) {
-    static char json_buf[262144];
-    int offset = 0;
+/* Append one skyline outline as a list of runs: [[x,y,x,y,...],...] */
+static void append_polyline_json(json_writer_t* w, const skyline_polyline_t* line) {
+    doom_json_char(w, '[');
+    for (int r = 0; r < line->run_count; r++) {
+        int first = line->run_start[r];
+        int last = (r + 1 < line->run_count) ? line->run_start[r + 1] : line->point_count;
+
+        if (r > 0) {
+            JSON_LITERAL(w, ",[");
+        } else {
+            doom_json_char(w, '[');
+        }
+        doom_json_points(w, (const short (*)[2])&line->points[first], last - first);
+        doom_json_char(w, ']');
+    }
+    doom_json_char(w, ']');
+}
+
+/* Quantise a projection scale to distance 0 (near) .. DEPTH_MAX (far) */
+static int scale_to_distance(fixed_t scale) {
+    int distance;
+    if (scale > 0x20000) {
+        distance = 0;
+    } else if (scale < 0x800) {
+        distance = DEPTH_MAX;
+    } else {
+        distance = DEPTH_MAX - ((scale - 0x800) * DEPTH_MAX) / (0x20000 - 0x800);
+    }
+    if (distance < 0) distance = 0;
+    if (distance > DEPTH_MAX) distance = DEPTH_MAX;
+    return distance;
+}
 
-    offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                      "{\"frame\":%d,\"walls\":[", g_frame_count);
+/* Vector extraction function (from our working code). viewpoint is 0 for
+ * the player's view, N for the Nth extra view (-view) of the same frame:
+ * those are always JSON and carry no motion history or weapon. */
+static char* extract_vectors_to_json(int frame, int viewpoint, size_t* out_len) {
+    static char json_buf[262144];
+    json_writer_t w;
+    doom_json_init(&w, json_buf, sizeof(json_buf));
+    int records = g_records && viewpoint == 0;
+
+    /* Timing and view samples for consumer-side interpolation */
+    if (viewpoint == 0) {
+        doom_motion_begin_frame(gametic);
+        doom_motion_record_view(viewx, viewy, viewz, viewangle);
+    }
+    doom_dynres_begin_frame();
+
+    JSON_LITERAL(&w, "{\"frame\":");
+    doom_json_int(&w, frame);
+    JSON_LITERAL(&w, ",\"tic\":");
+    doom_json_int(&w, gametic);
+    JSON_LITERAL(&w, ",\"time_us\":");
+    doom_json_u64(&w, doom_clock_us());
+    if (viewpoint > 0) {
+        JSON_LITERAL(&w, ",\"viewpoint\":");
+        doom_json_int(&w, viewpoint);
+    }
+    JSON_LITERAL(&w, ",\"view\":{\"x\":");
+    doom_json_int(&w, viewx);
+    JSON_LITERAL(&w, ",\"y\":");
+    doom_json_int(&w, viewy);
+    JSON_LITERAL(&w, ",\"z\":");
+    doom_json_int(&w, viewz);
+    JSON_LITERAL(&w, ",\"angle\":");
+    doom_json_uint(&w, viewangle);
+    doom_json_char(&w, '}');
+
+    const motion_view_t* prev = viewpoint == 0 ? doom_motion_prev_view() : NULL;
+    if (prev != NULL) {
+        JSON_LITERAL(&w, ",\"prev_tic\":");
+        doom_json_int(&w, prev->tic);
+        JSON_LITERAL(&w, ",\"prev_view\":{\"x\":");
+        doom_json_int(&w, prev->x);
+        JSON_LITERAL(&w, ",\"y\":");
+        doom_json_int(&w, prev->y);
+        JSON_LITERAL(&w, ",\"z\":");
+        doom_json_int(&w, prev->z);
+        JSON_LITERAL(&w, ",\"angle\":");
+        doom_json_uint(&w, prev->angle);
+        doom_json_char(&w, '}');
+    }
 
-    /* Extract walls */
-    int wall_count = ds_p - drawsegs;
+    /* Extract walls (skyline mode sends outlines instead). Walls and sprites
+     * are gathered first and emitted afterwards so they can be depth-ordered. */
+    int wall_count = g_skyline_mode ? 0 : ds_p - drawsegs;
     int wall_output = 0;
+    if (g_texedges_mode) {
+        doom_texedges_begin(&g_texedges);
+    }
 
     for (int i = 0; i < wall_count && i < MAXDRAWSEGS; i++) {
         drawseg_t* ds = &drawsegs[i];
@@ -150,16 +379,7 @@ static char* extract_vectors_to_json(size_t* out_len) {
         if (scale1 <= 0) scale1 = 1;
         if (scale2 <= 0) scale2 = 1;
 
-        int distance;
-        if (scale1 > 0x20000) {
-            distance = 0;
-        } else if (scale1 < 0x800) {
-            distance = 999;
-        } else {
-            distance = 999 - ((scale1 - 0x800) * 999) / (0x20000 - 0x800);
-        }
-        if (distance < 0) distance = 0;
-        if (distance > 999) distance = 999;
+        int distance = scale_to_distance(scale1);
 
         fixed_t ceiling_height = sector->ceilingheight;
         fixed_t floor_height = sector->floorheight;
@@ -187,20 +407,25 @@ static char* extract_vectors_to_json(size_t* out_len) {
         /* Get silhouette to determine if this is a solid wall or portal */
         int silhouette = ds->silhouette;
 
-        if (wall_output > 0) {
-            offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, ",");
+        /* Emitted in the output space (differs from the view under -dynres) */
+        wall_record_t* rec = &g_frame.walls[wall_output++];
+        rec->x1 = doom_dynres_x(x1);
+        rec->y1_top = doom_dynres_y(y1_top);
+        rec->y1_bottom = doom_dynres_y(y1_bottom);
+        rec->x2 = doom_dynres_x(x2);
+        rec->y2_top = doom_dynres_y(y2_top);
+        rec->y2_bottom = doom_dynres_y(y2_bottom);
+        rec->distance = distance;
+        rec->silhouette = silhouette;
+
+        if (g_texedges_mode) {
+            doom_texedges_wall(ds, wall_output - 1, &g_texedges);
         }
-
-        offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                          "[%d,%d,%d,%d,%d,%d,%d,%d]",
-                          x1, y1_top, y1_bottom, x2, y2_top, y2_bottom, distance, silhouette);
-        wall_output++;
     }
 
-    offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, "],\"entities\":[");
-
     /* Extract sprites */
     int sprite_count = vissprite_p - vissprites;
+    int sprite_output = 0;
 
     for (int i = 0; i < sprite_count && i < MAXVISSPRITES; i++) {
         vissprite_t* vis = &vissprites[i];
@@ -215,16 +440,7 @@ static char* extract_vectors_to_json(size_t* out_len) {
         fixed_t sprite_scale = vis->scale;
         if (sprite_scale <= 0) sprite_scale = 1;
 
-        int distance;
-        if (sprite_scale > 0x20000) {
-            distance = 0;
-        } else if (sprite_scale < 0x800) {
-            distance = 999;
-        } else {
-            distance = 999 - ((sprite_scale - 0x800) * 999) / (0x20000 - 0x800);
-        }
-        if (distance < 0) distance = 0;
-        if (distance > 999) distance = 999;
+        int distance = scale_to_distance(sprite_scale);
 
         fixed_t gzt = vis->gzt;
         fixed_t gz = vis->gz;
@@ -240,28 +456,138 @@ static char* extract_vectors_to_json(size_t* out_len) {
         if (y_bottom < 0) y_bottom = 0;
         if (y_bottom >= viewheight) y_bottom = viewheight - 1;
 
+        x = doom_dynres_x(x);
+        y_top = doom_dynres_y(y_top);
+        y_bottom = doom_dynres_y(y_bottom);
+
         int sprite_height = y_bottom - y_top;
         if (sprite_height < 5) sprite_height = 5;
 
         /* Extract real entity type from vissprite (captured during R_ProjectSprite) */
         int type = vis->mobjtype;  /* MT_PLAYER, MT_SHOTGUY, MT_BARREL, etc. */
 
-        if (i > 0) {
-            offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, ",");
+        sprite_record_t* rec = &g_frame.sprites[sprite_output++];
+        rec->x = x;
+        rec->y_top = y_top;
+        rec->y_bottom = y_bottom;
+        rec->height = sprite_height;
+        rec->type = type;
+        rec->distance = distance;
+        rec->id = 0;
+        rec->has_prev = 0;
+
+#ifdef KIDOOM_MOBJ_IDS
+        /* Stable ID + previous-tic position (patches/mobj_ids.patch) */
+        if (vis->mobjid != 0) {
+            rec->id = vis->mobjid;
+            if (viewpoint == 0) {
+                rec->has_prev = doom_motion_prev_sprite(vis->mobjid, rec->prev);
+                doom_motion_record_sprite(vis->mobjid, x, y_top, y_bottom);
+            }
         }
+#endif
+    }
 
-        offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                          "{\"x\":%d,\"y_top\":%d,\"y_bottom\":%d,\"height\":%d,\"type\":%d,\"distance\":%d}",
-                          x, y_top, y_bottom, sprite_height, type, distance);
+    g_frame.frame = frame;
+    g_frame.tic = gametic;
+    g_frame.wall_count = wall_output;
+    g_frame.sprite_count = sprite_output;
+
+    /* Emit walls and sprites, depth-ordered on request */
+    int total = wall_output + sprite_output;
+    for (int i = 0; i < total; i++) {
+        g_order[i] = (short)i;  /* Walls first, then sprites, as gathered */
+    }
+    if (g_depth_order >= 0) {
+        for (int i = 0; i < wall_output; i++) {
+            g_depth_keys[i] = (short)g_frame.walls[i].distance;
+        }
+        for (int i = 0; i < sprite_output; i++) {
+            g_depth_keys[wall_output + i] = (short)g_frame.sprites[i].distance;
+        }
+        doom_depth_sort(g_depth_keys, total, g_depth_order, g_order);
     }
 
-    offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, "],\"weapon\":");
+    if (records) {
+        /* Same emission order, as packed records ahead of the JSON */
+        uint8_t* out = doom_records_pack_frame(g_records_buf, &g_frame);
+        for (int i = 0; i < total; i++) {
+            if (g_order[i] < wall_output) {
+                out = doom_records_pack_wall(out, &g_frame.walls[g_order[i]]);
+            }
+        }
+        for (int i = 0; i < total; i++) {
+            if (g_order[i] >= wall_output) {
+                out = doom_records_pack_entity(out, &g_frame.sprites[g_order[i] - wall_output]);
+            }
+        }
+        g_records_len = out - g_records_buf;
+    } else {
+        JSON_LITERAL(&w, ",\"walls\":[");
+        int emitted = 0;
+        for (int i = 0; i < total; i++) {
+            if (g_order[i] >= wall_output) {
+                continue;
+            }
+            doom_json_wall(&w, &g_frame.walls[g_order[i]], emitted++ == 0);
+        }
+
+        JSON_LITERAL(&w, "],\"entities\":[");
+        emitted = 0;
+        for (int i = 0; i < total; i++) {
+            if (g_order[i] < wall_output) {
+                continue;
+            }
+            doom_json_entity(&w, &g_frame.sprites[g_order[i] - wall_output], emitted++ == 0);
+        }
+        doom_json_char(&w, ']');
+    }
+
+    /* Merge tags: walls[] and entities[] are each in draw order, "order"
+     * says which list the next primitive comes from ('w' or 's') */
+    if (g_depth_order >= 0) {
+        if (g_depth_order == DEPTH_NEAR_TO_FAR) {
+            JSON_LITERAL(&w, ",\"depth\":\"near\",\"order\":\"");
+        } else {
+            JSON_LITERAL(&w, ",\"depth\":\"far\",\"order\":\"");
+        }
+        for (int i = 0; i < total; i++) {
+            doom_json_char(&w, g_order[i] < wall_output ? 'w' : 's');
+        }
+        doom_json_char(&w, '"');
+    }
+
+    /* Texture edge lines: [wall, x1, y1, x2, y2], wall indexing "walls" */
+    if (g_texedges_mode) {
+        int slot = 0;
+        for (int i = 0; i < total; i++) {
+            if (g_order[i] < wall_output) {
+                g_wall_slot[g_order[i]] = (short)slot++;
+            }
+        }
+        doom_dynres_map_points(g_texedges.points, g_texedges.line_count * 2);
+
+        JSON_LITERAL(&w, ",\"edges\":[");
+        for (int i = 0; i < g_texedges.line_count; i++) {
+            if (i > 0) {
+                doom_json_char(&w, ',');
+            }
+            doom_json_char(&w, '[');
+            doom_json_int(&w, g_wall_slot[g_texedges.wall[i]]);
+            doom_json_char(&w, ',');
+            doom_json_points(&w, (const short (*)[2])&g_texedges.points[i * 2], 2);
+            doom_json_char(&w, ']');
+        }
+        doom_json_char(&w, ']');
+    }
+
+    JSON_LITERAL(&w, ",\"weapon\":");
 
     /* Weapon sprite */
     player_t* player = &players[consoleplayer];
     pspdef_t* weapon_psp = &player->psprites[ps_weapon];
 
-    if (weapon_psp->state != NULL) {
+    if (viewpoint == 0 && weapon_psp->state != NULL) {
         int wx = (weapon_psp->sx >> FRACBITS) + (viewwidth / 2);
         int wy = (weapon_psp->sy >> FRACBITS) + viewheight - 32;
 
@@ -269,17 +595,68 @@ static char* extract_vectors_to_json(size_t* out_len) {
         if (wx >= viewwidth) wx = viewwidth - 1;
         if (wy < 0) wy = 0;
         if (wy >= viewheight) wy = viewheight - 1;
-
-        offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                          "{\"x\":%d,\"y\":%d,\"visible\":true}", wx, wy);
+        wx = doom_dynres_x(wx);
+        wy = doom_dynres_y(wy);
+
+        JSON_LITERAL(&w, "{\"x\":");
+        doom_json_int(&w, wx);
+        JSON_LITERAL(&w, ",\"y\":");
+        doom_json_int(&w, wy);
+        JSON_LITERAL(&w, ",\"visible\":true}");
     } else {
-        offset += snprintf(json_buf + offset, sizeof(json_buf) - offset,
-                          "{\"visible\":false}");
+        JSON_LITERAL(&w, "{\"visible\":false}");
     }
 
-    offset += snprintf(json_buf + offset, sizeof(json_buf) - offset, "}");
+    /* Skyline outlines */
+    if (g_skyline_mode) {
+        doom_skyline_build(g_skyline_tolerance, &g_skyline_top, &g_skyline_bottom);
+        doom_dynres_map_points(g_skyline_top.points, g_skyline_top.point_count);
+        doom_dynres_map_points(g_skyline_bottom.points, g_skyline_bottom.point_count);
+
+        JSON_LITERAL(&w, ",\"skyline\":{\"tolerance\":");
+        doom_json_int(&w, g_skyline_tolerance);
+        JSON_LITERAL(&w, ",\"top\":");
+        append_polyline_json(&w, &g_skyline_top);
+        JSON_LITERAL(&w, ",\"bottom\":");
+        append_polyline_json(&w, &g_skyline_bottom);
+        doom_json_char(&w, '}');
+    }
+
+    /* Floor/ceiling polygons */
+    if (g_planes_mode) {
+        doom_visplanes_build(g_planes_tolerance, &g_planes);
+        doom_dynres_map_points(g_planes.points, g_planes.point_count);
+
+        JSON_LITERAL(&w, ",\"planes\":[");
+        for (int i = 0; i < g_planes.polygon_count; i++) {
+            const visplane_polygon_t* poly = &g_planes.polygons[i];
+
+            if (i > 0) {
+                doom_json_char(&w, ',');
+            }
+            JSON_LITERAL(&w, "{\"kind\":");
+            doom_json_int(&w, poly->kind);
+            JSON_LITERAL(&w, ",\"height\":");
+            doom_json_int(&w, poly->height);
+            JSON_LITERAL(&w, ",\"light\":");
+            doom_json_int(&w, poly->lightlevel);
+            JSON_LITERAL(&w, ",\"pic\":");
+            doom_json_int(&w, poly->picnum);
+            JSON_LITERAL(&w, ",\"poly\":[");
+            doom_json_points(&w, (const short (*)[2])&g_planes.points[poly->first_point],
+                             poly->point_count);
+            JSON_LITERAL(&w, "]}");
+        }
+        doom_json_char(&w, ']');
+    }
+
+    doom_json_char(&w, '}');
+
+    if (w.overflow) {
+        fprintf(stderr, "Warning: frame %d JSON truncated at %zu bytes\n", frame, w.len);
+    }
 
-    *out_len = offset;
+    *out_len = w.len;
     return json_buf;
 }
 
@@ -290,6 +667,171 @@ void DG_Init(){
 
   g_start_time_ms = get_time_ms();
 
+  g_headless = M_CheckParm("-headless");
+
+  /* DOOM loads the savegame itself and skips the title screen */
+  g_fast_start = M_CheckParmWithArgs("-loadgame", 1);
+  if (g_fast_start) {
+      printf("✓ Fast start: extraction begins at the first gameplay frame%s\n",
+             M_CheckParm("-nowipe") ? " (no wipe)" : "");
+  }
+
+  /* Session tracking; -record itself is handled by DOOM (G_RecordDemo) */
+  int record_arg = M_CheckParmWithArgs("-record", 1);
+  doom_session_init(record_arg ? myargv[record_arg + 1] : NULL,
+                    g_headless ? "headless" : "dual");
+  if (record_arg) {
+      /* Grow the demo buffer instead of ending the game when -maxdemo
+       * (128 KB by default, about 15 minutes) is full */
+      vanilla_demo_limit = 0;
+  }
+
+  /* R_InitData() has run: write the startup cache if it was rebuilt */
+  doom_cache_finish();
+
+  /* Plugin stops DOOM with SIGTERM - finish the demo on the main loop */
+  signal(SIGTERM, onQuitSignal);
+  signal(SIGINT, onQuitSignal);
+
+  /* Output mode options */
+  if (M_CheckParm("-skyline")) {
+      int p = M_CheckParmWithArgs("-skylinetol", 1);
+      g_skyline_mode = 1;
+      if (p) {
+          g_skyline_tolerance = atoi(myargv[p + 1]);
+      }
+      printf("✓ Skyline mode: outlines instead of walls (tolerance %dpx)\n", g_skyline_tolerance);
+  }
+
+  if (M_CheckParm("-planes")) {
+      int p = M_CheckParmWithArgs("-planetol", 1);
+      g_planes_mode = 1;
+      if (p) {
+          g_planes_tolerance = atoi(myargv[p + 1]);
+      }
+      printf("✓ Visplane polygons enabled (tolerance %dpx)\n", g_planes_tolerance);
+  }
+
+  if (M_CheckParm("-texedges")) {
+      int p = M_CheckParmWithArgs("-texedgecontrast", 1);
+      int contrast = p ? atoi(myargv[p + 1]) : TEXEDGE_DEFAULT_CONTRAST;
+      g_texedges_mode = 1;
+      doom_texedges_init(contrast);
+      printf("✓ Texture edge lines on walls (contrast %d)\n", contrast);
+  }
+
+  /* Thread placement: -gamecpu/-exportcpus/-rastercpus <list>, -rtprio <n> [-rtpolicy rr], -mlock */
+  int game_cpu_arg = M_CheckParmWithArgs("-gamecpu", 1);
+  int export_cpu_arg = M_CheckParmWithArgs("-exportcpus", 1);
+  int raster_cpu_arg = M_CheckParmWithArgs("-rastercpus", 1);
+  int rtprio_arg = M_CheckParmWithArgs("-rtprio", 1);
+  int rtpolicy_arg = M_CheckParmWithArgs("-rtpolicy", 1);
+  int policy = SCHED_POLICY_NORMAL;
+  int priority = 0;
+  if (rtprio_arg) {
+      priority = atoi(myargv[rtprio_arg + 1]);
+      policy = (rtpolicy_arg && !strcmp(myargv[rtpolicy_arg + 1], "rr"))
+               ? SCHED_POLICY_RR : SCHED_POLICY_FIFO;
+  }
+  /* Workers run one step below the game loop so they never preempt it */
+  if (doom_sched_configure(SCHED_ROLE_GAME, game_cpu_arg ? myargv[game_cpu_arg + 1] : NULL,
+                           policy, priority) < 0 ||
+      doom_sched_configure(SCHED_ROLE_EXPORT, export_cpu_arg ? myargv[export_cpu_arg + 1] : NULL,
+                           policy, priority - 1) < 0 ||
+      doom_sched_configure(SCHED_ROLE_RASTER, raster_cpu_arg ? myargv[raster_cpu_arg + 1] : NULL,
+                           policy, priority - 1) < 0) {
+      exit(1);
+  }
+  doom_sched_apply(SCHED_ROLE_GAME, 0);
+  if (M_CheckParm("-mlock")) {
+      doom_sched_lock_memory();
+  }
+  g_sched_stats = game_cpu_arg || export_cpu_arg || raster_cpu_arg || rtprio_arg || M_CheckParm("-mlock");
+
+  int export_arg = M_CheckParmWithArgs("-export", 1);
+  if (export_arg) {
+      int threads_arg = M_CheckParmWithArgs("-exportthreads", 1);
+      int formats = EXPORT_SVG;
+      if (M_CheckParm("-exportkicad")) {
+          formats |= EXPORT_KICAD;
+      }
+      if (doom_export_start(myargv[export_arg + 1], formats,
+                            threads_arg ? atoi(myargv[threads_arg + 1]) : EXPORT_DEFAULT_THREADS) == 0) {
+          g_export = 1;
+      }
+  }
+
+  if (M_CheckParm("-skipidle")) {
+      g_skip_idle = 1;
+      printf("✓ Idle-frame suppression (heartbeat every %d ms)\n", IDLE_HEARTBEAT_MS);
+  }
+
+  /* Live stats for doom_top; a name must start with '/' */
+  int stats_arg = M_CheckParm("-statsshm");
+  if (stats_arg) {
+      const char* name = STATS_SHM_DEFAULT;
+      if (stats_arg + 1 < myargc && myargv[stats_arg + 1][0] == '/') {
+          name = myargv[stats_arg + 1];
+      }
+      g_stats_shm = doom_stats_start(name) == 0;
+  }
+
+  /* Per-map frame size histograms for sizing consumer pools and buffers */
+  int telemetry_arg = M_CheckParmWithArgs("-telemetry", 1);
+  if (telemetry_arg) {
+      doom_telemetry_start(myargv[telemetry_arg + 1]);
+  }
+
+  /* Frame-time budget: trade view size/detail for time, keep coordinates */
+  int dynres_arg = M_CheckParmWithArgs("-dynres", 1);
+  if (dynres_arg) {
+      doom_dynres_start((uint64_t)(atof(myargv[dynres_arg + 1]) * 1000.0));
+      g_dynres = 1;
+  }
+
+  /* Start frames just in time for the consumer's pickup */
+  if (M_CheckParm("-pacing")) {
+      doom_pacing_start();
+  }
+
+  /* Pixel view drawn in vertical strips on a worker pool */
+  int raster_arg = M_CheckParmWithArgs("-rasterthreads", 1);
+  if (raster_arg) {
+      doom_raster_start(atoi(myargv[raster_arg + 1]));
+  }
+
+  int golden_arg = M_CheckParmWithArgs("-goldenwrite", 1);
+  if (golden_arg) {
+      g_golden = doom_golden_open(myargv[golden_arg + 1], GOLDEN_WRITE) == 0;
+  } else if ((golden_arg = M_CheckParmWithArgs("-golden", 1))) {
+      g_golden = doom_golden_open(myargv[golden_arg + 1], GOLDEN_CHECK) == 0;
+  }
+
+  int depth_arg = M_CheckParmWithArgs("-depthorder", 1);
+  if (depth_arg) {
+      if (!strcmp(myargv[depth_arg + 1], "near")) {
+          g_depth_order = DEPTH_NEAR_TO_FAR;
+      } else {
+          g_depth_order = DEPTH_FAR_TO_NEAR;
+      }
+      printf("✓ Depth-ordered output (%s to %s)\n",
+             g_depth_order == DEPTH_NEAR_TO_FAR ? "near" : "far",
+             g_depth_order == DEPTH_NEAR_TO_FAR ? "far" : "near");
+  }
+
+  int view_count = doom_views_parse();
+  if (view_count < 0) {
+      exit(1);
+  }
+
+  if (g_headless) {
+      if (view_count > 0) {
+          fprintf(stderr, "Warning: -view ignored in headless mode (no subscribers)\n");
+      }
+      printf("✓ Headless mode: extracting frames without SDL or socket\n\n");
+      return;
+  }
+
   /* Standard SDL initialization */
   window = SDL_CreateWindow("DOOM (SDL)",
                             0,                    /* X position */
@@ -314,20 +856,258 @@ void DG_Init(){
       exit(1);
   }
 
+  /* Binary records only for consumers built from the same schema */
+  uint64_t peer_schema = doom_socket_peer_schema();
+  if (peer_schema == RECORDS_SCHEMA_HASH) {
+      g_records = 1;
+      printf("✓ Frame records: schema %016llx\n", (unsigned long long)peer_schema);
+  } else if (peer_schema != 0) {
+      fprintf(stderr, "Warning: consumer record schema %016llx != %016llx, sending JSON frames\n",
+              (unsigned long long)peer_schema, (unsigned long long)RECORDS_SCHEMA_HASH);
+  }
+
+  /* Extra viewpoints: a subscriber that isn't listening just loses its view */
+  for (int i = 0; i < view_count; i++) {
+      if (doom_socket_connect_view(i, doom_views_get(i)->path) < 0) {
+          fprintf(stderr, "Warning: no subscriber for view %d, not rendering it\n", i + 1);
+          continue;
+      }
+      g_view_count = i + 1;
+  }
+  if (g_view_count > 0) {
+      printf("✓ Extra viewpoints: %d\n", g_view_count);
+  }
+
   printf("\n✓ Dual Mode Active\n");
   printf("  - SDL: Standard doomgeneric display\n");
   printf("  - Vectors: Sent to Python renderer\n\n");
 }
 
-void DG_DrawFrame()
-{
+/* Extract the rendered frame and hand it to the socket and the sinks */
+static void sendVectorFrame(void){
   /* Send vectors to Python renderer */
+  uint64_t frame_start_us = doom_clock_us();
   size_t json_len;
-  char* json_data = extract_vectors_to_json(&json_len);
-  if (doom_socket_send_frame(json_data, json_len) < 0) {
-      fprintf(stderr, "ERROR: Failed to send frame\n");
+  DOOM_TRACE1(extract__begin, g_frame_count);
+  char* json_data = extract_vectors_to_json(g_frame_count, 0, &json_len);
+  DOOM_TRACE4(extract__end, g_frame_count, g_frame.wall_count, g_frame.sprite_count,
+              g_records_len + json_len);
+  uint64_t extracted_us = doom_clock_us();
+  if (!g_headless) {
+      int sent = g_records
+          ? doom_socket_send_records(g_records_buf, g_records_len, json_data, json_len)
+          : doom_socket_send_frame(json_data, json_len);
+      if (sent < 0) {
+          fprintf(stderr, "ERROR: Failed to send frame\n");
+          finishDemoRecording();
+          exit(1);
+      }
+  }
+  doom_session_frame(gametic, g_records_len + json_len, doom_clock_us() - frame_start_us);
+  if (gamestate == GS_LEVEL) {
+      doom_telemetry_frame(g_frame.wall_count, g_frame.sprite_count, g_records_len + json_len,
+                           ds_p - drawsegs, vissprite_p - vissprites);
+  }
+
+  g_live.extract_us = extracted_us - frame_start_us;
+  g_live.send_us = doom_clock_us() - extracted_us;
+  g_live.frame_bytes = g_records_len + json_len;
+  if (!g_headless) {
+      doom_pacing_frame_sent(g_frame_count, doom_clock_us(),
+                             g_live.game_us + g_live.extract_us + g_live.send_us);
+  }
+
+  /* Simulate + render + extract + send, without sleeps and presentation */
+  if (g_dynres && g_frame_end_us != 0) {
+      uint64_t busy_us = doom_clock_us() - g_frame_end_us;
+      doom_dynres_frame(busy_us > g_slept_us ? busy_us - g_slept_us : 0);
+  }
+
+  if (g_export) {
+      doom_export_frame(&g_frame);
+  }
+  if (g_golden) {
+      doom_golden_frame(&g_frame);
+  }
+
+  if (!g_first_frame_sent && gamestate == GS_LEVEL) {
+      uint64_t startup_us = doom_clock_us() - g_process_start_us;
+      printf("✓ First vector frame after %.1f ms (tic %d)\n", startup_us / 1000.0, gametic);
+      doom_session_first_frame(startup_us);
+      g_first_frame_sent = 1;
+  }
+
+  g_last_send_us = doom_clock_us();
+}
+
+/* Render, extract and send every extra viewpoint (-view). Runs after the
+ * player's frame is done with: it overwrites the renderer state and g_frame. */
+static void sendViewFrames(int frame_id){
+  if (g_view_count == 0 || gamestate != GS_LEVEL || automapactive) {
+      return;
+  }
+
+  doom_views_begin();
+  for (int i = 0; i < g_view_count; i++) {
+      if (!doom_socket_view_connected(i)) {
+          continue;
+      }
+      doom_views_render(i);
+
+      size_t json_len;
+      char* json_data = extract_vectors_to_json(frame_id, i + 1, &json_len);
+      doom_socket_send_view(i, json_data, json_len);
+  }
+  doom_views_end();
+}
+
+/* Publish this frame's counters to the stats page (-statsshm) */
+static void publishStats(uint64_t present_us){
+  socket_stats_t net;
+  doom_socket_get_stats(&net);
+
+  g_live.frame = g_frame_count;
+  g_live.tic = gametic;
+  g_live.time_us = doom_clock_us();
+  g_live.frames_sent = net.frames;
+  g_live.idle_skipped = g_idle_frames;
+
+  g_live.present_us = present_us;
+  g_live.work_us = g_live.game_us + g_live.extract_us + g_live.send_us + present_us;
+  if (g_live.work_us > g_live.work_max_us) {
+      g_live.work_max_us = g_live.work_us;
+  }
+  if (g_live.work_us > STATS_LATE_US) {
+      g_live.late_frames++;
+  }
+
+  g_live.bytes_total = net.bytes;
+  g_live.write_calls = net.write_calls;
+  g_live.pending_messages = net.pending_messages;
+  g_live.export_queue = g_export ? doom_export_queue_depth() : 0;
+
+  g_live.walls = g_frame.wall_count;
+  g_live.sprites = g_frame.sprite_count;
+  g_live.view_width = viewwidth;
+  g_live.view_height = viewheight;
+
+  g_live.queue_us = doom_pacing_queue_us();
+  g_live.consumer_us = doom_pacing_present_us();
+
+  doom_stats_publish(&g_live);
+}
+
+/* -pacing: start the next frame just in time for the consumer's pickup */
+static void pacingDelay(void){
+  uint64_t delay_us = doom_pacing_delay_us(doom_clock_us());
+  g_live.pacing_us = delay_us;  /* Published with the next frame */
+  if (delay_us == 0) {
+      return;
+  }
+
+  uint64_t start_us = doom_clock_us();
+  usleep(delay_us);
+  g_slept_us += doom_clock_us() - start_us;
+}
+
+/* Level transitions: prefetch the next map while the intermission runs,
+ * and account the stall of the frame that set the new level up */
+static void trackLevelLoad(void){
+  if (gamestate == GS_INTERMISSION) {
+      doom_prefetch_next_level();
+  }
+
+  if (gamestate == GS_LEVEL && g_last_gamestate != GS_LEVEL && g_frame_end_us != 0) {
+      printf("✓ Level %d-%d on screen after a %.1f ms load\n",
+             gameepisode, gamemap, g_live.game_us / 1000.0);
+      doom_session_level_load(g_live.game_us);
+      doom_prefetch_finish();
+  }
+  g_last_gamestate = gamestate;
+}
+
+/* Compare the change signature with the last frame that was sent */
+static int frameIsIdle(void){
+  uint64_t signature = doom_idle_signature(g_texedges_mode);
+  if (g_have_signature && signature == g_last_signature) {
+      g_idle_frames++;
+      return 1;
+  }
+  g_last_signature = signature;
+  g_have_signature = 1;
+  return 0;
+}
+
+/* While idle, tell consumers we're alive without resending the frame */
+static void sendHeartbeat(void){
+  if (g_headless || doom_clock_us() - g_last_send_us < IDLE_HEARTBEAT_MS * 1000ULL) {
+      return;
+  }
+
+  char json_msg[96];
+  int len = snprintf(json_msg, sizeof(json_msg), "{\"frame\":%d,\"tic\":%d,\"idle_frames\":%d}",
+                     g_frame_count, gametic, g_idle_frames);
+  if (doom_socket_send_message(MSG_HEARTBEAT, json_msg, len) < 0) {
+      fprintf(stderr, "ERROR: Failed to send heartbeat\n");
+      finishDemoRecording();
       exit(1);
   }
+  g_last_send_us = doom_clock_us();
+}
+
+void DG_DrawFrame()
+{
+  if (g_quit_requested) {
+      puts("Quit signal received");
+      finishDemoRecording();
+      I_Quit();
+  }
+
+  /* Fast start: skip menus/wipes until the loaded level is on screen */
+  if (g_fast_start && !g_first_frame_sent && gamestate != GS_LEVEL) {
+      if (!g_headless) {
+          SDL_UpdateTexture(texture, NULL, DG_ScreenBuffer, DOOMGENERIC_RESX*sizeof(uint32_t));
+          SDL_RenderClear(renderer);
+          SDL_RenderCopy(renderer, texture, NULL, NULL);
+          SDL_RenderPresent(renderer);
+          handleKeyInput();
+      }
+      return;
+  }
+
+  int frame_id = g_frame_count;
+  DOOM_TRACE2(frame__begin, frame_id, gametic);
+
+  /* Tics and 3D render since the last frame, minus sleeping */
+  uint64_t draw_start_us = doom_clock_us();
+  g_live.game_us = 0;
+  if (g_frame_end_us != 0 && draw_start_us - g_frame_end_us > g_slept_us) {
+      g_live.game_us = draw_start_us - g_frame_end_us - g_slept_us;
+  }
+  trackLevelLoad();
+
+  /* Idle suppression: identical frame -> at most a heartbeat */
+  if (g_skip_idle && frameIsIdle()) {
+      sendHeartbeat();
+      g_live.extract_us = 0;
+      g_live.send_us = 0;
+      g_live.frame_bytes = 0;
+  } else {
+      sendVectorFrame();
+  }
+
+  if (g_headless) {
+      g_frame_count++;
+      g_frame_end_us = doom_clock_us();
+      g_slept_us = 0;
+      if (g_stats_shm) {
+          publishStats(0);
+      }
+      DOOM_TRACE2(frame__end, frame_id, g_live.frame_bytes);
+      return;
+  }
+
+  uint64_t present_start_us = doom_clock_us();
 
   /* Standard SDL rendering (known to work) */
   SDL_UpdateTexture(texture, NULL, DG_ScreenBuffer, DOOMGENERIC_RESX*sizeof(uint32_t));
@@ -338,6 +1118,11 @@ void DG_DrawFrame()
   handleKeyInput();
 
   g_frame_count++;
+  g_frame_end_us = doom_clock_us();
+  g_slept_us = 0;
+  if (g_stats_shm) {
+      publishStats(g_frame_end_us - present_start_us);
+  }
 
   /* Screenshot capture every 3 seconds (matches scope capture rate) */
   static uint32_t last_screenshot_time = 0;
@@ -354,6 +1139,8 @@ void DG_DrawFrame()
       snprintf(sdl_path, sizeof(sdl_path), "../assets/sdl_%u.bmp", current_time / 1000);
 
       /* Save SDL surface to BMP */
+      DOOM_TRACE1(screenshot__begin, frame_id);
+      int screenshot_result = -1;
       SDL_Surface* surface = SDL_CreateRGBSurfaceFrom(
           DG_ScreenBuffer,
           DOOMGENERIC_RESX,
@@ -368,11 +1155,12 @@ void DG_DrawFrame()
 
       if (surface) {
           if (SDL_SaveBMP(surface, sdl_path) == 0) {
-              /* Send screenshot message to Python */
+              /* Queue screenshot message - it rides along with the next frame */
               char json_msg[512];
               snprintf(json_msg, sizeof(json_msg), "{\"sdl_path\":\"%s\"}", sdl_path);
-              if (doom_socket_send_message(MSG_SCREENSHOT, json_msg, strlen(json_msg)) == 0) {
+              if (doom_socket_queue_message(MSG_SCREENSHOT, json_msg, strlen(json_msg)) == 0) {
                   printf("✓ SDL screenshot saved: %s\n", sdl_path);
+                  screenshot_result = 0;
               } else {
                   fprintf(stderr, "Warning: Failed to send screenshot message\n");
               }
@@ -383,6 +1171,7 @@ void DG_DrawFrame()
       } else {
           fprintf(stderr, "Warning: Failed to create SDL surface: %s\n", SDL_GetError());
       }
+      DOOM_TRACE2(screenshot__end, frame_id, screenshot_result);
 
       last_screenshot_time = current_time;
   }
@@ -392,14 +1181,46 @@ void DG_DrawFrame()
       float fps = (g_frame_count * 1000.0f) / elapsed_ms;
       int wall_count = ds_p - drawsegs;
       int sprite_count = vissprite_p - vissprites;
-      printf("Frame %d: %.1f FPS | Walls: %d | Sprites: %d\n",
-             g_frame_count, fps, wall_count, sprite_count);
+      socket_stats_t net;
+      doom_socket_get_stats(&net);
+      printf("Frame %d: %.1f FPS | Walls: %d | Sprites: %d | Syscalls/frame: %.2f (%llu msgs, %llu partial)\n",
+             g_frame_count, fps, wall_count, sprite_count,
+             net.frames ? (double)net.write_calls / net.frames : 0.0,
+             (unsigned long long)net.messages,
+             (unsigned long long)net.partial_writes);
+      if (g_view_count > 0) {
+          printf("Views: %llu frames sent, %llu skipped (subscriber behind), %.1f KB\n",
+                 (unsigned long long)net.view_frames, (unsigned long long)net.view_dropped,
+                 net.view_bytes / 1024.0);
+      }
+      if (g_sched_stats) {
+          doom_sched_report();
+      }
+      if (g_dynres) {
+          doom_dynres_report();
+      }
+      if (g_skip_idle) {
+          printf("Idle frames skipped: %d of %d\n", g_idle_frames, g_frame_count);
+      }
+      doom_pacing_report();
   }
+
+  sendViewFrames(frame_id);
+  pacingDelay();
+
+  DOOM_TRACE2(frame__end, frame_id, g_live.frame_bytes);
 }
 
 void DG_SleepMs(uint32_t ms)
 {
+  /* Oversleep beyond the requested time is the game thread's wake latency */
+  uint64_t start_us = doom_clock_us();
   SDL_Delay(ms);
+  uint64_t slept_us = doom_clock_us() - start_us;
+  g_slept_us += slept_us;
+  if (ms > 0 && slept_us > ms * 1000ULL) {
+      doom_sched_record_latency(SCHED_ROLE_GAME, slept_us - ms * 1000ULL);
+  }
 }
 
 uint32_t DG_GetTicksMs()
@@ -434,6 +1255,19 @@ void DG_SetWindowTitle(const char * title)
 
 int main(int argc, char **argv)
 {
+    g_process_start_us = doom_clock_us();
+
+    /* Before doomgeneric_Create(): R_InitData() runs inside it, and so
+     * does W_AddFile() */
+    doom_cache_install();
+    doom_prefetch_install();
+
+    /* Also before it: -warp loads (and precaches) the level inside it.
+     * Headless has no pixel sink unless -allassets asks for the full profile */
+    myargc = argc;
+    myargv = argv;
+    doom_assets_init(M_CheckParm("-headless") && !M_CheckParm("-allassets"));
+
     doomgeneric_Create(argc, argv);
 
     for (int i = 0; ; i++)
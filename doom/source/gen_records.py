@@ -0,0 +1,348 @@
+#!/usr/bin/env python3
+"""
+Generate the frame record packers and decoder from frame_records.schema.
+
+Outputs:
+    doom/source/doom_records.h             C packers (constant offsets)
+    kicad_doom_plugin/frame_records.py     Python struct / numpy decoder
+
+Both carry the same schema hash, which the consumer sends in INIT_COMPLETE;
+DOOM only sends MSG_FRAME_RECORDS when the hashes match.
+
+Usage:
+    python3 gen_records.py            # (re)generate both files
+    python3 gen_records.py --check    # exit 1 if a generated file is stale
+"""
+
+import os
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+PROJECT_ROOT = os.path.normpath(os.path.join(SCRIPT_DIR, '..', '..'))
+
+SCHEMA_PATH = os.path.join(SCRIPT_DIR, 'frame_records.schema')
+C_OUTPUT = os.path.join(SCRIPT_DIR, 'doom_records.h')
+PY_OUTPUT = os.path.join(PROJECT_ROOT, 'kicad_doom_plugin', 'frame_records.py')
+
+# type: (size, struct code, numpy code, C store width)
+TYPES = {
+    'i8':  (1, 'b', '<i1', 8),
+    'u8':  (1, 'B', '<u1', 8),
+    'i16': (2, 'h', '<i2', 16),
+    'u16': (2, 'H', '<u2', 16),
+    'i32': (4, 'i', '<i4', 32),
+    'u32': (4, 'I', '<u4', 32),
+}
+
+FNV_OFFSET_BASIS = 0xcbf29ce484222325
+FNV_PRIME = 0x100000001b3
+
+
+class Field:
+    def __init__(self, name, type_name, options):
+        self.name = name
+        self.count = 1
+        if '[' in type_name:
+            type_name, count = type_name.rstrip(']').split('[')
+            self.count = int(count)
+        if type_name not in TYPES:
+            raise ValueError(f"unknown type '{type_name}' for field '{name}'")
+        self.type = type_name
+        self.size, self.code, self.dtype, self.bits = TYPES[type_name]
+        self.member = options.get('c', name)
+        self.counts = options.get('count')
+        self.omitzero = 'omitzero' in options
+        self.hidden = 'hidden' in options
+        self.when = options.get('when')
+        self.offset = 0
+        self.index = 0  # Position in the unpacked tuple
+
+
+class Record:
+    def __init__(self, name, c_type, key, shape):
+        if shape not in ('list', 'dict'):
+            raise ValueError(f"record '{name}': shape must be list or dict")
+        self.name = name
+        self.c_type = c_type
+        self.key = None if key == '-' else key
+        self.shape = shape
+        self.fields = []
+        self.size = 0
+
+    def layout(self):
+        offset = 0
+        index = 0
+        for field in self.fields:
+            field.offset = offset
+            field.index = index
+            offset += field.size * field.count
+            index += field.count
+        self.size = offset
+
+    def struct_format(self):
+        return '<' + ''.join(f.code * f.count for f in self.fields)
+
+
+def parse_schema(text):
+    """
+    Parse the schema into records (in file order) and its canonical hash.
+
+    Returns:
+        (records, hash): list of Record, 64-bit FNV-1a of the canonical text
+    """
+    records = []
+    current = None
+    canonical = []
+
+    for number, raw in enumerate(text.splitlines(), 1):
+        line = raw.split('#', 1)[0].split()
+        if not line:
+            continue
+        canonical.append(' '.join(line))
+
+        if line[0] == 'record':
+            if current is not None or len(line) != 5:
+                raise ValueError(f"line {number}: expected 'record <name> <C type> <key> <shape>'")
+            current = Record(*line[1:])
+        elif line[0] == 'end':
+            if current is None:
+                raise ValueError(f"line {number}: 'end' outside a record")
+            current.layout()
+            records.append(current)
+            current = None
+        else:
+            if current is None or len(line) < 2:
+                raise ValueError(f"line {number}: field outside a record")
+            options = {}
+            for option in line[2:]:
+                key, _, value = option.partition('=')
+                options[key] = value
+            current.fields.append(Field(line[0], line[1], options))
+
+    if current is not None:
+        raise ValueError(f"record '{current.name}' is missing 'end'")
+    if not records or records[0].key is not None:
+        raise ValueError("the first record must be the frame header (key '-')")
+
+    h = FNV_OFFSET_BASIS
+    for byte in '\n'.join(canonical).encode('utf-8'):
+        h ^= byte
+        h = (h * FNV_PRIME) & 0xffffffffffffffff
+
+    return records, h
+
+
+def generate_c(records, schema_hash):
+    out = []
+    out.append('/**')
+    out.append(' * doom_records.h')
+    out.append(' *')
+    out.append(' * GENERATED by gen_records.py from frame_records.schema - do not edit.')
+    out.append(' *')
+    out.append(' * Binary frame record packers. Offsets and sizes are compile-time')
+    out.append(' * constants; values are stored packed and little-endian.')
+    out.append(' */')
+    out.append('')
+    out.append('#ifndef DOOM_RECORDS_H')
+    out.append('#define DOOM_RECORDS_H')
+    out.append('')
+    out.append('#include <stdint.h>')
+    out.append('')
+    out.append('#include "doom_frame.h"')
+    out.append('')
+    out.append('/* Hash of frame_records.schema, sent by the consumer in INIT_COMPLETE */')
+    out.append(f'#define RECORDS_SCHEMA_HASH 0x{schema_hash:016x}ULL')
+    out.append('')
+    out.append('static inline void records_put_8(uint8_t* p, uint32_t v) {')
+    out.append('    p[0] = (uint8_t)v;')
+    out.append('}')
+    out.append('')
+    out.append('static inline void records_put_16(uint8_t* p, uint32_t v) {')
+    out.append('    p[0] = (uint8_t)v;')
+    out.append('    p[1] = (uint8_t)(v >> 8);')
+    out.append('}')
+    out.append('')
+    out.append('static inline void records_put_32(uint8_t* p, uint32_t v) {')
+    out.append('    p[0] = (uint8_t)v;')
+    out.append('    p[1] = (uint8_t)(v >> 8);')
+    out.append('    p[2] = (uint8_t)(v >> 16);')
+    out.append('    p[3] = (uint8_t)(v >> 24);')
+    out.append('}')
+
+    for record in records:
+        prefix = f'RECORD_{record.name.upper()}'
+        out.append('')
+        out.append(f'/* {record.name} ({record.c_type}) */')
+        out.append(f'#define {prefix}_SIZE {record.size}')
+        for field in record.fields:
+            out.append(f'#define {prefix}_{field.name.upper()} {field.offset}')
+        out.append('')
+        out.append('/**')
+        out.append(f' * Pack one {record.name} record at out.')
+        out.append(' *')
+        out.append(f' * Returns: out + {prefix}_SIZE')
+        out.append(' */')
+        out.append(f'static inline uint8_t* doom_records_pack_{record.name}'
+                   f'(uint8_t* out, const {record.c_type}* r) {{')
+        for field in record.fields:
+            offset = f'{prefix}_{field.name.upper()}'
+            if field.count == 1:
+                out.append(f'    records_put_{field.bits}(out + {offset}, (uint32_t)r->{field.member});')
+            else:
+                for i in range(field.count):
+                    out.append(f'    records_put_{field.bits}(out + {offset} + {i * field.size}, '
+                               f'(uint32_t)r->{field.member}[{i}]);')
+        out.append(f'    return out + {prefix}_SIZE;')
+        out.append('}')
+
+    out.append('')
+    out.append('#endif /* DOOM_RECORDS_H */')
+    out.append('')
+    return '\n'.join(out)
+
+
+def python_decoder(record):
+    """Lines of the _decode_<name>(v) function for one record."""
+    out = [f'def _decode_{record.name}(v):']
+    if record.shape == 'list':
+        out.append('    return list(v)')
+        return out
+
+    def value(field):
+        if field.count == 1:
+            return f'v[{field.index}]'
+        return '[' + ', '.join(f'v[{field.index + i}]' for i in range(field.count)) + ']'
+
+    by_name = {f.name: f for f in record.fields}
+    plain = [f for f in record.fields if not (f.hidden or f.omitzero or f.when)]
+    items = ', '.join(f"'{f.name}': {value(f)}" for f in plain)
+    out.append(f'    d = {{{items}}}')
+    for field in record.fields:
+        if field.hidden:
+            continue
+        if field.omitzero:
+            out.append(f'    if v[{field.index}]:')
+            out.append(f"        d['{field.name}'] = {value(field)}")
+        elif field.when:
+            out.append(f'    if v[{by_name[field.when].index}]:')
+            out.append(f"        d['{field.name}'] = {value(field)}")
+    out.append('    return d')
+    return out
+
+
+def generate_python(records, schema_hash):
+    header = records[0]
+    by_name = {r.name: r for r in records}
+
+    out = []
+    out.append('"""')
+    out.append('Frame record decoder (MSG_FRAME_RECORDS).')
+    out.append('')
+    out.append('GENERATED by doom/source/gen_records.py from frame_records.schema - do not edit.')
+    out.append('')
+    out.append('decode_frame() returns the same dict json.loads() gives for MSG_FRAME_DATA,')
+    out.append('so renderers are unaffected by the transport. The *_DTYPE numpy dtypes')
+    out.append('(None without numpy) map the record arrays directly, for consumers that')
+    out.append('want to work on whole columns.')
+    out.append('"""')
+    out.append('')
+    out.append('import json')
+    out.append('import struct')
+    out.append('')
+    out.append('try:')
+    out.append('    import numpy as np')
+    out.append('except ImportError:')
+    out.append('    np = None')
+    out.append('')
+    out.append('# Hash of frame_records.schema, sent as "schema" in INIT_COMPLETE')
+    out.append(f'SCHEMA_HASH = 0x{schema_hash:016x}')
+    out.append(f"SCHEMA_HASH_HEX = '{schema_hash:016x}'")
+
+    for record in records:
+        name = record.name.upper()
+        out.append('')
+        out.append(f'# {record.name} ({record.size} bytes)')
+        out.append(f"{name} = struct.Struct('{record.struct_format()}')")
+        if record.shape == 'list':
+            for field in record.fields:
+                out.append(f'{name}_{field.name.upper()} = {field.index}')
+        dtype = []
+        for field in record.fields:
+            if field.count == 1:
+                dtype.append(f"('{field.name}', '{field.dtype}')")
+            else:
+                dtype.append(f"('{field.name}', '{field.dtype}', ({field.count},))")
+        out.append(f'{name}_DTYPE = np.dtype([{", ".join(dtype)}]) if np else None')
+
+    for record in records:
+        out.append('')
+        out.append('')
+        out.extend(python_decoder(record))
+
+    out.append('')
+    out.append('')
+    out.append('def decode_frame(payload):')
+    out.append('    """')
+    out.append('    Decode a MSG_FRAME_RECORDS payload into a frame dict.')
+    out.append('')
+    out.append('    Args:')
+    out.append('        payload: Message payload (bytes)')
+    out.append('')
+    out.append('    Returns:')
+    out.append('        dict: Same structure as a MSG_FRAME_DATA JSON frame')
+    out.append('    """')
+    out.append('    view = memoryview(payload)')
+    out.append(f'    header = {header.name.upper()}.unpack_from(view, 0)')
+    out.append(f'    offset = {header.name.upper()}.size')
+    counted = [f for f in header.fields if f.counts]
+    for field in counted:
+        record = by_name[field.counts]
+        name = record.name.upper()
+        out.append('')
+        out.append(f'    end = offset + header[{field.index}] * {name}.size')
+        out.append(f'    {record.key} = [_decode_{record.name}(v) for v in {name}.iter_unpack(view[offset:end])]')
+        out.append('    offset = end')
+    out.append('')
+    out.append('    data = json.loads(bytes(view[offset:])) if offset < len(view) else {}')
+    out.append(f'    data.update(_decode_{header.name}(header))')
+    for field in counted:
+        key = by_name[field.counts].key
+        out.append(f"    data['{key}'] = {key}")
+    out.append('    return data')
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    check = '--check' in sys.argv[1:]
+
+    with open(SCHEMA_PATH) as f:
+        records, schema_hash = parse_schema(f.read())
+
+    outputs = [
+        (C_OUTPUT, generate_c(records, schema_hash)),
+        (PY_OUTPUT, generate_python(records, schema_hash)),
+    ]
+
+    stale = 0
+    for path, content in outputs:
+        current = None
+        if os.path.exists(path):
+            with open(path) as f:
+                current = f.read()
+        if current == content:
+            continue
+        if check:
+            print(f"STALE: {path}")
+            stale += 1
+        else:
+            with open(path, 'w') as f:
+                f.write(content)
+            print(f"Generated {path}")
+
+    print(f"Schema hash: {schema_hash:016x}")
+    return 1 if stale else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -19,6 +19,10 @@ SOCKET_TIMEOUT = 10.0
 # Socket receive timeout during gameplay (seconds)
 SOCKET_RECV_TIMEOUT = 1.0
 
+# Input is sent as snapshots of all held keys (MSG_INPUT_STATE): on every
+# change and again at this interval, so a lost release can't leave a key stuck
+INPUT_STATE_INTERVAL_MS = 250
+
 # ============================================================================
 # Object Pool Sizes
 # ============================================================================
@@ -120,6 +124,77 @@ SLOW_FRAME_THRESHOLD = 0.050  # 50ms = 20 FPS
 # Warning threshold for FPS degradation
 MIN_ACCEPTABLE_FPS = 10.0
 
+# DOOM-side frame budget (milliseconds) for dynamic resolution (-dynres).
+# Heavy scenes drop to low detail / smaller view sizes to stay within it;
+# coordinates sent to the plugin don't change. None = fixed resolution.
+DOOM_FRAME_BUDGET_MS = None
+
+# Skip extraction and sending while nothing on screen changes (-skipidle).
+# The board keeps the last frame; DOOM sends a heartbeat once per second.
+DOOM_SKIP_IDLE_FRAMES = True
+
+# Receive walls/entities as binary records (MSG_FRAME_RECORDS) instead of
+# JSON. The layout comes from doom/source/frame_records.schema; DOOM falls
+# back to JSON if its schema hash differs from frame_records.py.
+# tests/records_roundtrip.c checks the records against the JSON path, and
+# tests/golden_check.py --records against a golden run.
+USE_FRAME_RECORDS = True
+
+# Publish live frame stats in shared memory (-statsshm) for doom/doom_top.
+# The game loop never waits on readers.
+DOOM_PUBLISH_STATS = True
+
+# Phase DOOM's frames to the refresh timer (-pacing): using the present
+# feedback the renderer sends, DOOM starts each frame so it is ready just
+# before the timer picks it up, instead of waiting in the queue.
+# Off by default: it adds a sleep of up to one refresh interval per frame,
+# driven by the feedback estimate. Set True to enable, then compare the
+# "Pacing: consumer queue ..." stats line with and without it.
+DOOM_JIT_PACING = False
+
+# Texture detail lines on walls (-texedges): door, switch and panel outlines
+# drawn as thin traces inside each wall box. They share the trace pool with
+# walls, so raise MAX_WALL_TRACES when enabling this.
+DOOM_TEXTURE_EDGES = False
+
+# Extra viewpoints rendered every tic, one subscriber socket each (-view).
+# Specs: "rear" or "cam:x,y,angle[,height]", optionally "@/socket/path"
+# (default /tmp/kicad_doom_view<N>.sock). Subscribers must already be
+# listening, e.g. python3 run_standalone_renderer.py /tmp/kicad_doom_view1.sock
+DOOM_EXTRA_VIEWS = []
+
+# ============================================================================
+# Thread Scheduling
+# ============================================================================
+
+# Pin DOOM's game loop to these CPUs, e.g. "3" or "2-3" (None = OS decides).
+# Linux only; ignored with a warning elsewhere.
+DOOM_GAME_CPUS = None
+
+# Real-time priority for the game loop (SCHED_FIFO, capped at 49).
+# None = normal scheduling. Needs CAP_SYS_NICE or an RLIMIT_RTPRIO grant.
+DOOM_RT_PRIORITY = None
+
+# Lock DOOM's memory to avoid page faults (needs RLIMIT_MEMLOCK headroom)
+DOOM_LOCK_MEMORY = False
+
+# ============================================================================
+# Session Recording
+# ============================================================================
+
+# Record every session as a DOOM demo (-record) plus .session.json metadata.
+# Replay offline with: doomgeneric_kicad -headless -timedemo <session>
+RECORD_SESSIONS = False
+
+# Directory for recorded sessions (relative to plugin directory)
+SESSION_DIR_NAME = "sessions"
+
+# Start directly from a savegame slot (0-5) instead of the title screen.
+# None = normal startup. Skipping the screen wipe as well needs
+# doom/source/patches/nowipe.patch (adds -nowipe).
+FAST_START_SAVE_SLOT = None
+FAST_START_NO_WIPE = False
+
 # ============================================================================
 # File Paths
 # ============================================================================
@@ -142,6 +217,12 @@ def get_doom_binary_path():
     return os.path.join(plugin_dir, "doom", DOOM_BINARY_NAME)
 
 
+def get_session_directory():
+    """Get the absolute path to the recorded session directory."""
+    plugin_dir = get_plugin_directory()
+    return os.path.join(plugin_dir, "doom", SESSION_DIR_NAME)
+
+
 def get_wad_file_path():
     """Get the absolute path to the WAD file."""
     plugin_dir = get_plugin_directory()
@@ -206,6 +287,10 @@ MSG_FRAME_DATA = 0x01      # DOOM -> Python: Frame rendering data
 MSG_KEY_EVENT = 0x02       # Python -> DOOM: Keyboard event
 MSG_INIT_COMPLETE = 0x03   # Python -> DOOM: Initialization complete
 MSG_SHUTDOWN = 0x04        # Bidirectional: Request shutdown
+MSG_HEARTBEAT = 0x06       # DOOM -> Python: Idle, last frame still current
+MSG_FRAME_RECORDS = 0x07   # DOOM -> Python: Binary records + JSON tail
+MSG_INPUT_STATE = 0x08     # Python -> DOOM: Held keys bitmap + sequence number
+MSG_PRESENT_FEEDBACK = 0x09  # Python -> DOOM: Frame presented + wait/decode/render times
 
 # ============================================================================
 # Debug Settings
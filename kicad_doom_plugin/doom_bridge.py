@@ -14,6 +14,13 @@ Message Types:
     0x02: KEY_EVENT     - Python -> DOOM (keyboard input)
     0x03: INIT_COMPLETE - Python -> DOOM (ready signal)
     0x04: SHUTDOWN      - Bidirectional (cleanup)
+    0x06: HEARTBEAT     - DOOM -> Python (idle, last frame still current)
+    0x07: FRAME_RECORDS - DOOM -> Python (binary walls/entities + JSON tail,
+                          sent when INIT_COMPLETE announced our schema hash)
+    0x08: INPUT_STATE   - Python -> DOOM (binary: uint32 sequence + 256-bit
+                          bitmap of held DOOM keys; DOOM diffs it into events)
+    0x09: PRESENT_FEEDBACK - Python -> DOOM (frame presented: wait/decode/render
+                          times, for DOOM's just-in-time pacing)
 """
 
 import socket
@@ -24,9 +31,11 @@ import os
 import time
 from .config import (
     SOCKET_PATH, SOCKET_TIMEOUT, SOCKET_RECV_TIMEOUT,
-    MSG_FRAME_DATA, MSG_KEY_EVENT, MSG_INIT_COMPLETE, MSG_SHUTDOWN,
+    MSG_FRAME_DATA, MSG_KEY_EVENT, MSG_INIT_COMPLETE, MSG_SHUTDOWN, MSG_HEARTBEAT,
+    MSG_FRAME_RECORDS, MSG_INPUT_STATE, MSG_PRESENT_FEEDBACK, USE_FRAME_RECORDS,
     DEBUG_MODE, LOG_SOCKET
 )
+from . import frame_records
 
 
 class DoomBridge:
@@ -60,6 +69,11 @@ class DoomBridge:
         self.frames_received = 0
         self.total_receive_time = 0.0
         self.receive_errors = 0
+        self.heartbeats_received = 0
+
+        # Input snapshots (sent from the input handler's threads)
+        self.input_seq = 0
+        self.send_lock = threading.Lock()
 
     def setup_socket(self):
         """
@@ -119,7 +133,9 @@ class DoomBridge:
 
         # Send initialization complete message
         try:
-            self._send_message(MSG_INIT_COMPLETE, {})
+            # Announcing the record schema makes DOOM send MSG_FRAME_RECORDS
+            init = {'schema': frame_records.SCHEMA_HASH_HEX} if USE_FRAME_RECORDS else {}
+            self._send_message(MSG_INIT_COMPLETE, init)
             if DEBUG_MODE:
                 print("[OK] Sent INIT_COMPLETE to DOOM")
         except Exception as e:
@@ -179,16 +195,22 @@ class DoomBridge:
                         print("Connection closed by DOOM (payload)")
                     break
 
-                # Parse JSON
+                # Parse JSON (records frames carry a binary prefix)
+                decode_start = time.monotonic()
                 try:
-                    data = json.loads(payload.decode('utf-8'))
-                except json.JSONDecodeError as e:
-                    print(f"ERROR: Invalid JSON payload: {e}")
+                    if msg_type == MSG_FRAME_RECORDS:
+                        data = frame_records.decode_frame(payload)
+                    else:
+                        data = json.loads(payload.decode('utf-8'))
+                    # Reported back with the present (see send_present_feedback)
+                    data['_decode_us'] = int((time.monotonic() - decode_start) * 1e6)
+                except (json.JSONDecodeError, struct.error) as e:
+                    print(f"ERROR: Invalid payload: {e}")
                     self.receive_errors += 1
                     continue
 
                 # Handle message based on type
-                if msg_type == MSG_FRAME_DATA:
+                if msg_type in (MSG_FRAME_DATA, MSG_FRAME_RECORDS):
                     # Render frame (this is the hot path)
                     receive_start = time.time()
                     try:
@@ -202,6 +224,10 @@ class DoomBridge:
                             traceback.print_exc()
                         self.receive_errors += 1
 
+                elif msg_type == MSG_HEARTBEAT:
+                    # DOOM is idle - the board already shows the current frame
+                    self.heartbeats_received += 1
+
                 elif msg_type == MSG_SHUTDOWN:
                     print("DOOM requested shutdown")
                     self.running = False
@@ -267,7 +293,8 @@ class DoomBridge:
         try:
             payload = json.dumps(data).encode('utf-8')
             header = struct.pack('II', msg_type, len(payload))
-            self.connection.sendall(header + payload)
+            with self.send_lock:
+                self.connection.sendall(header + payload)
 
             if LOG_SOCKET:
                 print(f"Sent message: type={msg_type:#04x}, len={len(payload)}")
@@ -297,6 +324,62 @@ class DoomBridge:
         except Exception as e:
             print(f"WARNING: Failed to send key event: {e}")
 
+    def send_input_state(self, held_keys):
+        """
+        Send the set of held DOOM keys as one input snapshot.
+
+        DOOM turns the difference to the previous snapshot into key events,
+        and ignores snapshots older than one it already applied, so sending
+        the same state again (periodically) is always safe.
+
+        Args:
+            held_keys: Collection of DOOM key codes (0-255) currently held;
+                       pass the live set, it is read under the send lock
+
+        Example:
+            bridge.send_input_state({0x77, 0xAC})  # Forward + turn left
+        """
+        try:
+            with self.send_lock:
+                # Read the keys under the lock that orders the sequence
+                # numbers, so a later snapshot never carries older keys
+                bitmap = bytearray(32)
+                for key in tuple(held_keys):
+                    bitmap[key >> 3] |= 1 << (key & 7)
+
+                self.input_seq = (self.input_seq + 1) & 0xFFFFFFFF
+                payload = struct.pack('I', self.input_seq) + bytes(bitmap)
+                self.connection.sendall(struct.pack('II', MSG_INPUT_STATE, len(payload)) + payload)
+
+            if LOG_SOCKET:
+                print(f"Sent input state: seq={self.input_seq}, keys={len(held_keys)}")
+        except Exception as e:
+            print(f"WARNING: Failed to send input state: {e}")
+
+    def send_present_feedback(self, frame, wait_us, decode_us, render_us, interval_us):
+        """
+        Tell DOOM a frame has been presented, and how long it took to get
+        there. DOOM uses this to finish frames just before the next pickup.
+
+        Args:
+            frame: Frame number from the frame data
+            wait_us: Time the frame waited for the refresh timer
+            decode_us: Time spent decoding it in the receive thread
+            render_us: Time from pickup to the end of Refresh()
+            interval_us: Refresh timer interval
+        """
+        try:
+            self._send_message(MSG_PRESENT_FEEDBACK, {
+                'frame': frame,
+                'wait_us': wait_us,
+                'decode_us': decode_us,
+                'render_us': render_us,
+                'interval_us': interval_us
+            })
+        except Exception as e:
+            if DEBUG_MODE:
+                print(f"WARNING: Failed to send present feedback: {e}")
+
     def stop(self):
         """
         Shutdown socket and cleanup resources.
@@ -349,6 +432,7 @@ class DoomBridge:
             if self.frames_received > 0:
                 avg_time = self.total_receive_time / self.frames_received
                 print(f"Average frame time: {avg_time*1000:.2f}ms")
+            print(f"Idle heartbeats: {self.heartbeats_received}")
             print(f"Receive errors: {self.receive_errors}")
             print("=" * 70 + "\n")
 
@@ -372,5 +456,6 @@ class DoomBridge:
             'frames_received': self.frames_received,
             'total_receive_time': self.total_receive_time,
             'receive_errors': self.receive_errors,
+            'heartbeats_received': self.heartbeats_received,
             'is_running': self.is_running(),
         }
@@ -28,7 +28,11 @@ import logging
 from datetime import datetime
 
 from .config import (
-    get_doom_binary_path, get_wad_file_path, DEBUG_MODE
+    get_doom_binary_path, get_wad_file_path, get_session_directory,
+    DEBUG_MODE, RECORD_SESSIONS, FAST_START_SAVE_SLOT, FAST_START_NO_WIPE,
+    DOOM_GAME_CPUS, DOOM_RT_PRIORITY, DOOM_LOCK_MEMORY, DOOM_FRAME_BUDGET_MS,
+    DOOM_SKIP_IDLE_FRAMES, DOOM_PUBLISH_STATS, DOOM_EXTRA_VIEWS, DOOM_JIT_PACING,
+    DOOM_TEXTURE_EDGES
 )
 from .pcb_renderer import DoomPCBRenderer
 from .doom_bridge import DoomBridge
@@ -142,6 +146,7 @@ class DoomKiCadPlugin(pcbnew.ActionPlugin):
             # Create bridge (socket server)
             self.logger.info("Creating communication bridge...")
             bridge = DoomBridge(renderer)
+            renderer.present_callback = bridge.send_present_feedback
 
             # Setup socket FIRST (creates and starts listening)
             self.logger.info("Setting up socket server...")
@@ -202,9 +207,43 @@ class DoomKiCadPlugin(pcbnew.ActionPlugin):
 
         try:
             # Launch DOOM (SDL window + socket connection)
-            self.logger.info(f"Launching DOOM: {doom_binary}")
+            doom_args = [doom_binary]
+            if RECORD_SESSIONS:
+                # Demo lump + .session.json for offline reproduction
+                session_dir = get_session_directory()
+                os.makedirs(session_dir, exist_ok=True)
+                session_name = datetime.now().strftime("session_%Y%m%d_%H%M%S")
+                doom_args += ['-record', os.path.join(session_dir, session_name)]
+                self.logger.info(f"Recording session: {session_name}")
+
+            # Keep the game loop from being descheduled behind KiCad's UI
+            if DOOM_GAME_CPUS is not None:
+                doom_args += ['-gamecpu', str(DOOM_GAME_CPUS)]
+            if DOOM_RT_PRIORITY is not None:
+                doom_args += ['-rtprio', str(DOOM_RT_PRIORITY)]
+            if DOOM_LOCK_MEMORY:
+                doom_args.append('-mlock')
+            if DOOM_FRAME_BUDGET_MS is not None:
+                doom_args += ['-dynres', str(DOOM_FRAME_BUDGET_MS)]
+            if DOOM_SKIP_IDLE_FRAMES:
+                doom_args.append('-skipidle')
+            if DOOM_PUBLISH_STATS:
+                doom_args.append('-statsshm')
+            if DOOM_JIT_PACING:
+                doom_args.append('-pacing')
+            if DOOM_TEXTURE_EDGES:
+                doom_args.append('-texedges')
+            for view in DOOM_EXTRA_VIEWS:
+                doom_args += ['-view', view]
+
+            if FAST_START_SAVE_SLOT is not None:
+                doom_args += ['-loadgame', str(FAST_START_SAVE_SLOT)]
+                if FAST_START_NO_WIPE:
+                    doom_args.append('-nowipe')
+
+            self.logger.info(f"Launching DOOM: {' '.join(doom_args)}")
             doom_process = subprocess.Popen(
-                [doom_binary],
+                doom_args,
                 cwd=os.path.dirname(doom_binary),
                 stdout=subprocess.PIPE,
                 stderr=subprocess.PIPE,
@@ -0,0 +1,89 @@
+"""
+Frame record decoder (MSG_FRAME_RECORDS).
+
+GENERATED by doom/source/gen_records.py from frame_records.schema - do not edit.
+
+decode_frame() returns the same dict json.loads() gives for MSG_FRAME_DATA,
+so renderers are unaffected by the transport. The *_DTYPE numpy dtypes
+(None without numpy) map the record arrays directly, for consumers that
+want to work on whole columns.
+"""
+
+import json
+import struct
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+# Hash of frame_records.schema, sent as "schema" in INIT_COMPLETE
+SCHEMA_HASH = 0x3fe90c0702777f70
+SCHEMA_HASH_HEX = '3fe90c0702777f70'
+
+# frame (12 bytes)
+FRAME = struct.Struct('<iiHH')
+FRAME_DTYPE = np.dtype([('frame', '<i4'), ('tic', '<i4'), ('wall_count', '<u2'), ('entity_count', '<u2')]) if np else None
+
+# wall (27 bytes)
+WALL = struct.Struct('<iiiiiiHB')
+WALL_X1 = 0
+WALL_Y1_TOP = 1
+WALL_Y1_BOTTOM = 2
+WALL_X2 = 3
+WALL_Y2_TOP = 4
+WALL_Y2_BOTTOM = 5
+WALL_DISTANCE = 6
+WALL_SILHOUETTE = 7
+WALL_DTYPE = np.dtype([('x1', '<i4'), ('y1_top', '<i4'), ('y1_bottom', '<i4'), ('x2', '<i4'), ('y2_top', '<i4'), ('y2_bottom', '<i4'), ('distance', '<u2'), ('silhouette', '<u1')]) if np else None
+
+# entity (37 bytes)
+ENTITY = struct.Struct('<iiiiHHiBiii')
+ENTITY_DTYPE = np.dtype([('x', '<i4'), ('y_top', '<i4'), ('y_bottom', '<i4'), ('height', '<i4'), ('type', '<u2'), ('distance', '<u2'), ('id', '<i4'), ('has_prev', '<u1'), ('prev', '<i4', (3,))]) if np else None
+
+
+def _decode_frame(v):
+    d = {'frame': v[0], 'tic': v[1]}
+    return d
+
+
+def _decode_wall(v):
+    return list(v)
+
+
+def _decode_entity(v):
+    d = {'x': v[0], 'y_top': v[1], 'y_bottom': v[2], 'height': v[3], 'type': v[4], 'distance': v[5]}
+    if v[6]:
+        d['id'] = v[6]
+    if v[7]:
+        d['prev'] = [v[8], v[9], v[10]]
+    return d
+
+
+def decode_frame(payload):
+    """
+    Decode a MSG_FRAME_RECORDS payload into a frame dict.
+
+    Args:
+        payload: Message payload (bytes)
+
+    Returns:
+        dict: Same structure as a MSG_FRAME_DATA JSON frame
+    """
+    view = memoryview(payload)
+    header = FRAME.unpack_from(view, 0)
+    offset = FRAME.size
+
+    end = offset + header[2] * WALL.size
+    walls = [_decode_wall(v) for v in WALL.iter_unpack(view[offset:end])]
+    offset = end
+
+    end = offset + header[3] * ENTITY.size
+    entities = [_decode_entity(v) for v in ENTITY.iter_unpack(view[offset:end])]
+    offset = end
+
+    data = json.loads(bytes(view[offset:])) if offset < len(view) else {}
+    data.update(_decode_frame(header))
+    data['walls'] = walls
+    data['entities'] = entities
+    return data
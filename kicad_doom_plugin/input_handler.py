@@ -2,7 +2,8 @@
 Keyboard input handler for DOOM controls.
 
 Captures OS-level keyboard events using pynput and forwards them to DOOM
-via the socket bridge.
+via the socket bridge, as snapshots of the held keys (MSG_INPUT_STATE) sent
+on every change and every INPUT_STATE_INTERVAL_MS.
 
 Why pynput:
 - KiCad's Python plugin doesn't provide event loop access
@@ -45,7 +46,9 @@ except ImportError:
     print("WARNING: pynput not installed. Input will not work.")
     print("Install with: pip install pynput")
 
-from .config import DEBUG_MODE
+import threading
+
+from .config import DEBUG_MODE, INPUT_STATE_INTERVAL_MS
 
 
 class DoomInputHandler:
@@ -117,7 +120,9 @@ class DoomInputHandler:
         """
         self.bridge = bridge
         self.listener = None
-        self.pressed_keys = set()  # Track pressed keys to avoid repeats
+        self.pressed_keys = set()  # Held DOOM keys (the snapshot we send)
+        self.refresh_thread = None
+        self.stop_event = threading.Event()
 
         if not PYNPUT_AVAILABLE:
             print("ERROR: Input handler cannot start (pynput not installed)")
@@ -152,6 +157,11 @@ class DoomInputHandler:
         )
         self.listener.start()
 
+        # Resend the held keys periodically (repairs anything lost in transit)
+        self.stop_event.clear()
+        self.refresh_thread = threading.Thread(target=self._refresh_loop, daemon=True)
+        self.refresh_thread.start()
+
         if DEBUG_MODE:
             print("[OK] Input listener started")
 
@@ -178,7 +188,7 @@ class DoomInputHandler:
                 # Only send if not already pressed (avoid key repeat)
                 if doom_key not in self.pressed_keys:
                     self.pressed_keys.add(doom_key)
-                    self.bridge.send_key_event(pressed=True, key_code=doom_key)
+                    self.bridge.send_input_state(self.pressed_keys)
 
                     if DEBUG_MODE:
                         print(f"Key press: {key_char} -> DOOM key {doom_key:#04x}")
@@ -208,7 +218,7 @@ class DoomInputHandler:
                 # Only send if actually pressed
                 if doom_key in self.pressed_keys:
                     self.pressed_keys.remove(doom_key)
-                    self.bridge.send_key_event(pressed=False, key_code=doom_key)
+                    self.bridge.send_input_state(self.pressed_keys)
 
                     if DEBUG_MODE:
                         print(f"Key release: {key_char} -> DOOM key {doom_key:#04x}")
@@ -217,12 +227,26 @@ class DoomInputHandler:
             if DEBUG_MODE:
                 print(f"ERROR: Key release handler failed: {e}")
 
+    def _refresh_loop(self):
+        """
+        Resend the current snapshot every INPUT_STATE_INTERVAL_MS.
+
+        Runs in a background thread until stop().
+        """
+        while not self.stop_event.wait(INPUT_STATE_INTERVAL_MS / 1000.0):
+            self.bridge.send_input_state(self.pressed_keys)
+
     def stop(self):
         """
         Stop keyboard listener and cleanup.
 
         Safe to call multiple times.
         """
+        self.stop_event.set()
+        if self.refresh_thread:
+            self.refresh_thread.join(timeout=1.0)
+            self.refresh_thread = None
+
         if self.listener:
             try:
                 self.listener.stop()
@@ -88,6 +88,11 @@ class DoomPCBRenderer:
 
         # Refresh timer (runs on main thread)
         self.refresh_timer = None
+        self.refresh_interval_ms = 0
+
+        # Called with (frame, wait_us, decode_us, render_us, interval_us)
+        # after each present, e.g. DoomBridge.send_present_feedback
+        self.present_callback = None
 
         print("\n[OK] Renderer initialized")
         print("=" * 70 + "\n")
@@ -125,6 +130,8 @@ class DoomPCBRenderer:
                 hud: Dictionary with HUD elements
         """
         try:
+            frame_data['_queued_at'] = time.monotonic()
+
             # Try to add frame to queue (non-blocking)
             # If queue is full, drop oldest frame (keep most recent)
             try:
@@ -157,7 +164,7 @@ class DoomPCBRenderer:
         try:
             # 1. Render walls (most objects, highest priority)
             walls = frame_data.get('walls', [])
-            wall_trace_count = self._render_walls(walls)
+            wall_trace_count = self._render_walls(walls, frame_data.get('edges', []))
 
             # 2. Render entities (player, enemies)
             entities = frame_data.get('entities', [])
@@ -208,7 +215,7 @@ class DoomPCBRenderer:
         if self.frame_count % CLEANUP_INTERVAL == 0:
             self._periodic_cleanup()
 
-    def _render_walls(self, walls):
+    def _render_walls(self, walls, texture_edges=()):
         """
         Render wall segments as wireframe PCB traces.
 
@@ -218,10 +225,14 @@ class DoomPCBRenderer:
         - Left edge: (x1, y1_top) -> (x1, y1_bottom)
         - Right edge: (x2, y2_top) -> (x2, y2_bottom)
 
+        Texture edge lines (DOOM -texedges) follow their wall's box as thin
+        traces.
+
         Distance from player determines layer (F.Cu/B.Cu) and width.
 
         Args:
             walls: List of [x1, y1_top, y1_bottom, x2, y2_top, y2_bottom, distance, silhouette]
+            texture_edges: List of [wall_index, x1, y1, x2, y2]
 
         Returns:
             int: Number of traces used for walls
@@ -229,7 +240,11 @@ class DoomPCBRenderer:
         trace_pool = self.pools['traces']
         trace_index = 0
 
-        for wall in walls:
+        details_by_wall = {}
+        for edge in texture_edges:
+            details_by_wall.setdefault(edge[0], []).append(tuple(edge[1:5]))
+
+        for index, wall in enumerate(walls):
             if len(wall) < 8:
                 continue  # Invalid wall data (need wireframe format)
 
@@ -246,9 +261,11 @@ class DoomPCBRenderer:
                 (x1, y1_top, x1, y1_bottom),       # Left edge
                 (x2, y2_top, x2, y2_bottom)        # Right edge
             ]
+            box_edges = len(edges)
+            edges += details_by_wall.get(index, [])
 
             # Render each edge as a separate trace
-            for (sx, sy, ex, ey) in edges:
+            for edge_index, (sx, sy, ex, ey) in enumerate(edges):
                 # Check pool capacity
                 if trace_index >= len(trace_pool.objects):
                     if DEBUG_MODE:
@@ -271,8 +288,9 @@ class DoomPCBRenderer:
                 # All walls are blue (B.Cu) for consistency
                 # Close walls: thick traces (bright)
                 # Far walls: thin traces (dim)
+                # Texture detail: always thin
                 trace.SetLayer(pcbnew.B_Cu)
-                if distance < DISTANCE_THRESHOLD:
+                if distance < DISTANCE_THRESHOLD and edge_index < box_edges:
                     trace.SetWidth(TRACE_WIDTH_CLOSE)
                 else:
                     trace.SetWidth(TRACE_WIDTH_FAR)
@@ -541,6 +559,7 @@ class DoomPCBRenderer:
         self.refresh_timer = wx.Timer()
         self.refresh_timer.Bind(wx.EVT_TIMER, self._on_refresh_timer)
         self.refresh_timer.Start(interval_ms)
+        self.refresh_interval_ms = interval_ms
 
         print(f"[OK] Started refresh timer ({1000/interval_ms:.1f} FPS max)")
 
@@ -555,6 +574,7 @@ class DoomPCBRenderer:
         try:
             # Get frame from queue (non-blocking)
             frame_data = self.frame_queue.get_nowait()
+            pickup = time.monotonic()
 
             # Process frame on main thread (safe!)
             self._process_frame(frame_data)
@@ -569,6 +589,15 @@ class DoomPCBRenderer:
             refresh_time = time.time() - refresh_start
             self.total_refresh_time += refresh_time
 
+            # Present feedback for DOOM's pacing
+            if self.present_callback and 'frame' in frame_data:
+                self.present_callback(
+                    frame_data['frame'],
+                    int((pickup - frame_data.get('_queued_at', pickup)) * 1e6),
+                    frame_data.get('_decode_us', 0),
+                    int((time.monotonic() - pickup) * 1e6),
+                    self.refresh_interval_ms * 1000)
+
         except queue.Empty:
             # No frame available - that's okay, just wait for next timer event
             pass
@@ -101,23 +101,61 @@ class DoomScope:
             points.append((x, y))
         return points
 
+    def skyline_to_points(self, skyline):
+        """
+        Convert skyline outlines (DOOM -skyline mode) to oscilloscope points.
+
+        Each outline is a list of runs, each run a flat [x, y, x, y, ...] list.
+        """
+        points = []
+        last_x, last_y = 0, 0
+
+        for outline in (skyline.get('top', []), skyline.get('bottom', [])):
+            for run in outline:
+                vertices = [self.doom_to_scope(run[i], run[i + 1])
+                            for i in range(0, len(run) - 1, 2)]
+                if not vertices:
+                    continue
+
+                # Blank move to start of run
+                if points:
+                    points.extend(self.line_to_points(last_x, last_y,
+                                                      vertices[0][0], vertices[0][1],
+                                                      BLANK_SAMPLES))
+
+                for (ax, ay), (bx, by) in zip(vertices, vertices[1:]):
+                    points.extend(self.line_to_points(ax, ay, bx, by, SAMPLES_PER_LINE))
+                last_x, last_y = vertices[-1]
+
+        return points
+
     def frame_to_points(self, frame):
         """Convert a DOOM frame to oscilloscope points."""
         points = []
 
+        # Skyline mode: two outlines replace all wall quads
+        skyline = frame.get('skyline')
+        if skyline:
+            points.extend(self.skyline_to_points(skyline))
+
         walls = frame.get('walls', [])
         entities = frame.get('entities', [])
 
+        # Texture edge lines (DOOM -texedges), traced with their wall
+        texture_edges = {}
+        for edge in frame.get('edges', []):
+            texture_edges.setdefault(edge[0], []).append(edge[1:])
+
         # Sort by distance (far to near) so closer walls are drawn last (brighter)
         all_objects = []
 
-        for wall in walls:
+        for index, wall in enumerate(walls):
             if isinstance(wall, list) and len(wall) >= 7:
                 distance = wall[6]
                 silhouette = wall[7] if len(wall) >= 8 else 3
                 if silhouette == 0:  # Skip portals
                     continue
-                all_objects.append(('wall', distance, wall))
+                all_objects.append(('wall', distance, (index, wall)))
 
         for entity in entities:
             distance = entity.get('distance', 100)
@@ -130,7 +168,7 @@ class DoomScope:
 
         for obj_type, distance, obj_data in all_objects:
             if obj_type == 'wall':
-                wall = obj_data
+                index, wall = obj_data
                 x1, y1_top, y1_bottom, x2, y2_top, y2_bottom = wall[:6]
 
                 # Convert to scope coordinates
@@ -146,6 +184,8 @@ class DoomScope:
                     (sx1, sy1_top, sx1, sy1_bottom),   # Left
                     (sx2, sy2_top, sx2, sy2_bottom),   # Right
                 ]
+                for tx1, ty1, tx2, ty2 in texture_edges.get(index, []):
+                    edges.append(self.doom_to_scope(tx1, ty1) + self.doom_to_scope(tx2, ty2))
 
                 for ex1, ey1, ex2, ey2 in edges:
                     # Blank move to start of line
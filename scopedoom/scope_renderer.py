@@ -273,6 +273,44 @@ class ScopeRenderer:
         scale_y = SCREEN_HEIGHT / DOOM_HEIGHT # 400/200 = 2.0
         return int(x * scale_x), int(y * scale_y)
 
+    def _draw_planes(self, planes):
+        """Fill floor/ceiling polygons from the frame's 'planes' list."""
+        for plane in planes:
+            coords = plane.get('poly', [])
+            if len(coords) < 6:
+                continue  # Need at least a triangle
+
+            points = [self.doom_to_screen(coords[i], coords[i + 1])
+                      for i in range(0, len(coords) - 1, 2)]
+
+            # Sector light (0-255) sets brightness, kind sets the tint
+            brightness = int(plane.get('light', 128) * 80 / 255)
+            kind = plane.get('kind', 0)
+            if kind == 0:
+                color = (brightness, brightness, 0)  # Floor: yellow/brown tint
+            elif kind == 1:
+                color = (0, brightness, brightness)  # Ceiling: cyan tint
+            else:
+                color = (0, 0, brightness // 2)      # Sky: dim blue
+
+            pygame.draw.polygon(self.screen, color, points)
+
+    def _merge_ordered(self, frame, order):
+        """Merge pre-sorted walls/entities using the frame's 'order' tags."""
+        walls = enumerate(frame.get('walls', []))
+        entities = iter(frame.get('entities', []))
+        walls_list = []
+        for tag in order:
+            if tag == 'w':
+                index, wall = next(walls)
+                # Skip portals (silhouette 0), same as the unsorted path
+                if len(wall) >= 8 and wall[7] != 0:
+                    walls_list.append(('wall', wall[6], wall, index))
+            else:
+                entity = next(entities)
+                walls_list.append(('sprite', entity.get('distance', 100), entity, None))
+        return walls_list
+
     def render_frame(self):
         """Render frame with proper occlusion using filled polygons."""
         self.screen.fill(COLOR_BG)
@@ -287,53 +325,70 @@ class ScopeRenderer:
             pygame.display.flip()
             return
 
-        # Collect all walls with distance
-        walls = frame.get('walls', [])
-        walls_list = []
-        for wall in walls:
-            if isinstance(wall, list) and len(wall) >= 8:
-                distance = wall[6]
-                silhouette = wall[7]
-                # Render solid walls (partial and full)
-                # silhouette=0: portal/opening (skip - these are empty space)
-                # silhouette=1: lower wall only (render - stairs/steps)
-                # silhouette=2: upper wall only (render - windows/openings)
-                # silhouette=3: full solid wall (render)
-                if silhouette == 0:
-                    continue
-                walls_list.append(('wall', distance, wall))
-
-        # Collect all entities with distance
-        entities = frame.get('entities', [])
-        for entity in entities:
-            distance = entity.get('distance', 100)
-            walls_list.append(('sprite', distance, entity))
-
-        # Sort ALL objects by distance (far to near) for proper occlusion
-        walls_list.sort(key=lambda x: x[1], reverse=True)
-
-        # Draw floor and ceiling gradients FIRST (before walls)
-        # Floor: gradient from horizon (center) to bottom (brighter near player)
-        horizon_y = SCREEN_HEIGHT // 2
-        for y in range(horizon_y, SCREEN_HEIGHT):
-            # Distance from horizon (0.0 at horizon, 1.0 at bottom)
-            t = (y - horizon_y) / (SCREEN_HEIGHT - horizon_y)
-            # Brightness: darker at horizon, brighter at bottom
-            brightness = int(80 * t)  # 0 at horizon, 80 at bottom
-            floor_color = (brightness, brightness, 0)  # Yellow/brown tint
-            pygame.draw.line(self.screen, floor_color, (0, y), (SCREEN_WIDTH, y), 1)
-
-        # Ceiling: gradient from horizon (center) to top (brighter away from horizon)
-        for y in range(0, horizon_y):
-            # Distance from top (1.0 at top, 0.0 at horizon)
-            t = (horizon_y - y) / horizon_y
-            # Brightness: darker at horizon, brighter at top
-            brightness = int(60 * t)  # 0 at horizon, 60 at top
-            ceiling_color = (0, brightness, brightness)  # Cyan tint
-            pygame.draw.line(self.screen, ceiling_color, (0, y), (SCREEN_WIDTH, y), 1)
+        order = frame.get('order')
+        if order is not None:
+            # DOOM already depth-sorted (-depthorder): merge by tag
+            walls_list = self._merge_ordered(frame, order)
+            if frame.get('depth') == 'near':
+                walls_list.reverse()  # We draw back to front
+        else:
+            # Collect all walls with distance
+            walls = frame.get('walls', [])
+            walls_list = []
+            for index, wall in enumerate(walls):
+                if isinstance(wall, list) and len(wall) >= 8:
+                    distance = wall[6]
+                    silhouette = wall[7]
+                    # Render solid walls (partial and full)
+                    # silhouette=0: portal/opening (skip - these are empty space)
+                    # silhouette=1: lower wall only (render - stairs/steps)
+                    # silhouette=2: upper wall only (render - windows/openings)
+                    # silhouette=3: full solid wall (render)
+                    if silhouette == 0:
+                        continue
+                    walls_list.append(('wall', distance, wall, index))
+
+            # Collect all entities with distance
+            entities = frame.get('entities', [])
+            for entity in entities:
+                distance = entity.get('distance', 100)
+                walls_list.append(('sprite', distance, entity, None))
+
+            # Sort ALL objects by distance (far to near) for proper occlusion
+            walls_list.sort(key=lambda x: x[1], reverse=True)
+
+        # Draw floor and ceiling FIRST (before walls)
+        planes = frame.get('planes')
+        if planes:
+            # Real visplane polygons (DOOM run with -planes)
+            self._draw_planes(planes)
+        else:
+            # Floor: gradient from horizon (center) to bottom (brighter near player)
+            horizon_y = SCREEN_HEIGHT // 2
+            for y in range(horizon_y, SCREEN_HEIGHT):
+                # Distance from horizon (0.0 at horizon, 1.0 at bottom)
+                t = (y - horizon_y) / (SCREEN_HEIGHT - horizon_y)
+                # Brightness: darker at horizon, brighter at bottom
+                brightness = int(80 * t)  # 0 at horizon, 80 at bottom
+                floor_color = (brightness, brightness, 0)  # Yellow/brown tint
+                pygame.draw.line(self.screen, floor_color, (0, y), (SCREEN_WIDTH, y), 1)
+
+            # Ceiling: gradient from horizon (center) to top (brighter away from horizon)
+            for y in range(0, horizon_y):
+                # Distance from top (1.0 at top, 0.0 at horizon)
+                t = (horizon_y - y) / horizon_y
+                # Brightness: darker at horizon, brighter at top
+                brightness = int(60 * t)  # 0 at horizon, 60 at top
+                ceiling_color = (0, brightness, brightness)  # Cyan tint
+                pygame.draw.line(self.screen, ceiling_color, (0, y), (SCREEN_WIDTH, y), 1)
+
+        # Texture edge lines (DOOM run with -texedges), drawn with their wall
+        edges_by_wall = {}
+        for edge in frame.get('edges', []):
+            edges_by_wall.setdefault(edge[0], []).append(edge)
 
         # Draw all objects in order (back to front)
-        for obj_type, distance, obj_data in walls_list:
+        for obj_type, distance, obj_data, index in walls_list:
             if obj_type == 'wall':
                 # Draw wall
                 wall = obj_data
@@ -371,6 +426,11 @@ class ScopeRenderer:
                 # Right edge
                 pygame.draw.line(self.screen, wall_color, (x2_s, y2t_s), (x2_s, y2b_s), 2)
 
+                # Detail lines from the wall's texture (doors, switches, panels)
+                for _, ex1, ey1, ex2, ey2 in edges_by_wall.get(index, []):
+                    pygame.draw.line(self.screen, wall_color,
+                                     self.doom_to_screen(ex1, ey1), self.doom_to_screen(ex2, ey2), 1)
+
             elif obj_type == 'sprite':
                 # Draw sprite
                 entity = obj_data
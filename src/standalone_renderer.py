@@ -523,6 +523,11 @@ class MinimalRenderer:
 
 
 def main():
+    # Optional socket path, e.g. /tmp/kicad_doom_view1.sock for a -view subscriber
+    global SOCKET_PATH
+    if len(sys.argv) > 1:
+        SOCKET_PATH = sys.argv[1]
+
     renderer = MinimalRenderer()
     renderer.run()
 
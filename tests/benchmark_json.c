@@ -0,0 +1,195 @@
+/**
+ * benchmark_json.c
+ *
+ * JSON frame encoder benchmark: the snprintf() formatting the extractor used
+ * before doom_json.c versus the fixed-schema writer. Both encode the same
+ * synthetic frames; the outputs must be byte-identical, then each encoder is
+ * timed over many frames.
+ *
+ * Build from the project root (after build.sh has copied the platform files
+ * into ../doomgeneric):
+ *   DG=../doomgeneric/doomgeneric
+ *   cc -O2 -I $DG tests/benchmark_json.c $DG/doom_json.c -o benchmark_json
+ *   ./benchmark_json
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "doom_frame.h"
+#include "doom_json.h"
+
+#define FRAMES      64      /* Distinct synthetic frames */
+#define ITERATIONS  20000   /* Frames encoded per encoder */
+#define WALLS       120     /* Busy room */
+#define SPRITES     16
+
+static doom_frame_t g_frames[FRAMES];
+static char g_ref_buf[262144];
+static char g_fast_buf[262144];
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/**
+ * Helper: Plausible screen-space frame (negative values included).
+ */
+static void make_frame(doom_frame_t* frame, int index) {
+    frame->frame = index * 7;
+    frame->tic = index * 2;
+
+    frame->wall_count = WALLS;
+    for (int i = 0; i < WALLS; i++) {
+        wall_record_t* w = &frame->walls[i];
+        w->x1 = rand() % 320;
+        w->x2 = w->x1 + rand() % 40;
+        w->y1_top = rand() % 200 - 20;
+        w->y1_bottom = rand() % 200;
+        w->y2_top = rand() % 200 - 20;
+        w->y2_bottom = rand() % 200;
+        w->distance = rand() % 1000;
+        w->silhouette = rand() % 4;
+    }
+
+    frame->sprite_count = SPRITES;
+    for (int i = 0; i < SPRITES; i++) {
+        sprite_record_t* e = &frame->sprites[i];
+        e->x = rand() % 320;
+        e->y_top = rand() % 200;
+        e->y_bottom = rand() % 200;
+        e->height = rand() % 100 + 5;
+        e->type = rand() % 140;
+        e->distance = rand() % 1000;
+        e->id = (i % 2) ? rand() % 5000 + 1 : 0;
+        e->has_prev = (i % 4) == 1;
+        e->prev[0] = rand() % 320;
+        e->prev[1] = rand() % 200;
+        e->prev[2] = rand() % 200;
+    }
+}
+
+/**
+ * Reference: the snprintf() encoder (header, walls, entities).
+ */
+static size_t encode_snprintf(const doom_frame_t* frame, char* buf, size_t size) {
+    int offset = 0;
+
+    offset += snprintf(buf + offset, size - offset,
+                      "{\"frame\":%d,\"tic\":%d,\"time_us\":%llu,"
+                      "\"view\":{\"x\":%d,\"y\":%d,\"z\":%d,\"angle\":%u}",
+                      frame->frame, frame->tic, 81234567890ULL + frame->tic,
+                      68157440, -236978176, 2686976, 1073741824u);
+
+    offset += snprintf(buf + offset, size - offset, ",\"walls\":[");
+    for (int i = 0; i < frame->wall_count; i++) {
+        const wall_record_t* w = &frame->walls[i];
+        offset += snprintf(buf + offset, size - offset,
+                          "%s[%d,%d,%d,%d,%d,%d,%d,%d]", i > 0 ? "," : "",
+                          w->x1, w->y1_top, w->y1_bottom, w->x2, w->y2_top, w->y2_bottom,
+                          w->distance, w->silhouette);
+    }
+
+    offset += snprintf(buf + offset, size - offset, "],\"entities\":[");
+    for (int i = 0; i < frame->sprite_count; i++) {
+        const sprite_record_t* e = &frame->sprites[i];
+        offset += snprintf(buf + offset, size - offset,
+                          "%s{\"x\":%d,\"y_top\":%d,\"y_bottom\":%d,\"height\":%d,\"type\":%d,\"distance\":%d",
+                          i > 0 ? "," : "",
+                          e->x, e->y_top, e->y_bottom, e->height, e->type, e->distance);
+        if (e->id != 0) {
+            offset += snprintf(buf + offset, size - offset, ",\"id\":%d", e->id);
+        }
+        if (e->has_prev) {
+            offset += snprintf(buf + offset, size - offset,
+                              ",\"prev\":[%d,%d,%d]", e->prev[0], e->prev[1], e->prev[2]);
+        }
+        offset += snprintf(buf + offset, size - offset, "}");
+    }
+    offset += snprintf(buf + offset, size - offset, "]}");
+
+    return offset;
+}
+
+/**
+ * Same output through doom_json.c.
+ */
+static size_t encode_fast(const doom_frame_t* frame, char* buf, size_t size) {
+    json_writer_t w;
+    doom_json_init(&w, buf, size);
+
+    JSON_LITERAL(&w, "{\"frame\":");
+    doom_json_int(&w, frame->frame);
+    JSON_LITERAL(&w, ",\"tic\":");
+    doom_json_int(&w, frame->tic);
+    JSON_LITERAL(&w, ",\"time_us\":");
+    doom_json_u64(&w, 81234567890ULL + frame->tic);
+    JSON_LITERAL(&w, ",\"view\":{\"x\":");
+    doom_json_int(&w, 68157440);
+    JSON_LITERAL(&w, ",\"y\":");
+    doom_json_int(&w, -236978176);
+    JSON_LITERAL(&w, ",\"z\":");
+    doom_json_int(&w, 2686976);
+    JSON_LITERAL(&w, ",\"angle\":");
+    doom_json_uint(&w, 1073741824u);
+    doom_json_char(&w, '}');
+
+    JSON_LITERAL(&w, ",\"walls\":[");
+    for (int i = 0; i < frame->wall_count; i++) {
+        doom_json_wall(&w, &frame->walls[i], i == 0);
+    }
+    JSON_LITERAL(&w, "],\"entities\":[");
+    for (int i = 0; i < frame->sprite_count; i++) {
+        doom_json_entity(&w, &frame->sprites[i], i == 0);
+    }
+    JSON_LITERAL(&w, "]}");
+
+    return w.len;
+}
+
+int main(void) {
+    srand(1234);
+    for (int i = 0; i < FRAMES; i++) {
+        make_frame(&g_frames[i], i);
+    }
+
+    /* Byte-identical output first */
+    size_t bytes = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        size_t ref_len = encode_snprintf(&g_frames[i], g_ref_buf, sizeof(g_ref_buf));
+        size_t fast_len = encode_fast(&g_frames[i], g_fast_buf, sizeof(g_fast_buf));
+        if (ref_len != fast_len || memcmp(g_ref_buf, g_fast_buf, ref_len) != 0) {
+            printf("FAIL: frame %d differs (%zu vs %zu bytes)\n", i, ref_len, fast_len);
+            return 1;
+        }
+        bytes += ref_len;
+    }
+    printf("Output identical for %d frames (avg %zu bytes)\n", FRAMES, bytes / FRAMES);
+
+    volatile size_t sink = 0;
+
+    double start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) {
+        sink += encode_snprintf(&g_frames[i % FRAMES], g_ref_buf, sizeof(g_ref_buf));
+    }
+    double ref_us = (now_us() - start) / ITERATIONS;
+
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) {
+        sink += encode_fast(&g_frames[i % FRAMES], g_fast_buf, sizeof(g_fast_buf));
+    }
+    double fast_us = (now_us() - start) / ITERATIONS;
+
+    printf("\n");
+    printf("BENCHMARK RESULTS (%d walls, %d entities per frame)\n", WALLS, SPRITES);
+    printf("==================================================================\n");
+    printf("snprintf encoder:  %8.2f us/frame\n", ref_us);
+    printf("doom_json writer:  %8.2f us/frame\n", fast_us);
+    printf("Speedup:           %8.1fx\n", ref_us / fast_us);
+
+    return 0;
+}
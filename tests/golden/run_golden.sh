@@ -0,0 +1,47 @@
+#!/bin/bash
+# KiDoom - Golden hash regression run over DOOM's built-in demos
+#
+# Checks every stock demo of doom1.wad against the hashes checked in next to
+# this script (DOOM's -golden), or rewrites them with --update after an
+# intended change to the extraction output.
+
+cd "$(dirname "$0")/../.."
+
+DOOM_BINARY="doom/doomgeneric_kicad"
+IWAD="doom/doom1.wad"
+GOLDEN_DIR="tests/golden"
+DEMOS="demo1 demo2 demo3"
+
+MODE="-golden"
+if [[ "$1" == "--update" ]]; then
+    MODE="-goldenwrite"
+elif [[ $# -gt 0 ]]; then
+    echo "Usage: $0 [--update]"
+    exit 2
+fi
+
+if [[ ! -f "$DOOM_BINARY" ]]; then
+    echo "ERROR: DOOM binary not found: $DOOM_BINARY"
+    echo "Build it with: cd doom/source && ./build.sh"
+    exit 1
+fi
+
+FAILED=0
+for demo in $DEMOS; do
+    golden="$GOLDEN_DIR/$demo.golden"
+    if [[ "$MODE" == "-golden" && ! -f "$golden" ]]; then
+        echo "$demo: no reference hashes ($golden), run with --update first"
+        FAILED=1
+        continue
+    fi
+
+    # -timedemo ends through I_Error, so the verdict comes from the output
+    output=$("$DOOM_BINARY" -iwad "$IWAD" -headless -timedemo "$demo" $MODE "$golden" 2>&1)
+    verdict=$(echo "$output" | grep "^Golden:")
+    echo "$demo: ${verdict:-no verdict (did DOOM start?)}"
+    if [[ "$MODE" == "-golden" && "$verdict" != *PASS* ]]; then
+        FAILED=1
+    fi
+done
+
+exit $FAILED
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""
+Golden-Hash Transport Check
+
+Stands in for the renderer on the DOOM socket, decodes every frame it
+receives and hashes the canonical form exactly like doom_golden.c does on the
+C side. Comparing against a golden file written by the reference JSON path
+(-goldenwrite) verifies that an encoder/transport change delivers the same
+walls and sprites.
+
+Canonical form:
+- walls: [x1, y1_top, y1_bottom, x2, y2_top, y2_bottom, distance, silhouette]
+- sprites: [x, y_top, y_bottom, height, type, distance]
+- each list sorted lexicographically, hashed as
+  FNV-1a 64(count, fields...) over little-endian int32 values
+- the frame's tic must match too (as with DOOM's -golden)
+
+With --records the checker announces the plugin's record schema in
+INIT_COMPLETE, so DOOM sends MSG_FRAME_RECORDS, and decodes them with
+kicad_doom_plugin/frame_records.py: the binary packers and the generated
+decoder then have to reproduce the golden file written from the JSON path.
+
+Usage:
+    # 1. Reference hashes straight from the extractor
+    ./doomgeneric_kicad -iwad doom1.wad -headless -timedemo demo1 -goldenwrite demo1.golden
+
+    # 2. Check what actually arrives over the socket
+    python3 tests/golden_check.py demo1.golden &
+    ./doomgeneric_kicad -iwad doom1.wad -timedemo demo1
+
+    # 3. Same over binary frame records
+    python3 tests/golden_check.py --records demo1.golden &
+    ./doomgeneric_kicad -iwad doom1.wad -timedemo demo1
+"""
+
+import socket
+import struct
+import json
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', 'kicad_doom_plugin'))
+import frame_records  # noqa: E402
+
+
+SOCKET_PATH = "/tmp/kicad_doom.sock"
+
+# Message type constants
+MSG_FRAME_DATA = 0x01
+MSG_INIT_COMPLETE = 0x03
+MSG_SHUTDOWN = 0x04
+MSG_FRAME_RECORDS = 0x07
+
+FNV_OFFSET_BASIS = 0xcbf29ce484222325
+FNV_PRIME = 0x100000001b3
+MASK_64 = 0xffffffffffffffff
+
+
+def fnv1a_ints(values):
+    """FNV-1a 64 over int32 values (little-endian)."""
+    h = FNV_OFFSET_BASIS
+    for byte in struct.pack(f'<{len(values)}i', *values):
+        h ^= byte
+        h = (h * FNV_PRIME) & MASK_64
+    return h
+
+
+def canonical_frame(frame):
+    """Return (walls, sprites) as sorted integer tuples."""
+    walls = sorted(tuple(w[:8]) for w in frame.get('walls', []))
+    sprites = sorted(
+        (e['x'], e['y_top'], e['y_bottom'], e['height'], e['type'], e['distance'])
+        for e in frame.get('entities', [])
+    )
+    return walls, sprites
+
+
+def hash_frame(frame):
+    """Return (walls_hash, sprites_hash, walls, sprites) for a decoded frame."""
+    walls, sprites = canonical_frame(frame)
+    walls_values = [len(walls)] + [v for w in walls for v in w]
+    sprites_values = [len(sprites)] + [v for s in sprites for v in s]
+    return fnv1a_ints(walls_values), fnv1a_ints(sprites_values), walls, sprites
+
+
+def load_golden(path):
+    """Load golden lines: [(index, tic, walls_hash, sprites_hash), ...]."""
+    entries = []
+    with open(path) as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) == 4:
+                entries.append((int(parts[0]), int(parts[1]),
+                                int(parts[2], 16), int(parts[3], 16)))
+    return entries
+
+
+def recv_exactly(conn, n):
+    """Receive exactly n bytes (None on disconnect)."""
+    data = b''
+    while len(data) < n:
+        chunk = conn.recv(n - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+def run_check(golden_path, records=False):
+    golden = load_golden(golden_path)
+    print(f"Loaded {len(golden)} golden frames from {golden_path}")
+
+    try:
+        os.unlink(SOCKET_PATH)
+    except FileNotFoundError:
+        pass
+
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(SOCKET_PATH)
+    server.listen(1)
+    print("Waiting for DOOM...")
+    conn, _ = server.accept()
+
+    # Announcing the record schema makes DOOM send MSG_FRAME_RECORDS
+    init = {'schema': frame_records.SCHEMA_HASH_HEX} if records else {}
+    payload = json.dumps(init).encode('utf-8')
+    conn.sendall(struct.pack('II', MSG_INIT_COMPLETE, len(payload)) + payload)
+
+    index = 0
+    mismatches = 0
+    first_mismatch = None
+    json_frames = 0
+
+    while True:
+        header = recv_exactly(conn, 8)
+        if header is None:
+            break
+        msg_type, payload_len = struct.unpack('II', header)
+        payload = recv_exactly(conn, payload_len)
+        if payload is None:
+            break
+        if msg_type == MSG_SHUTDOWN:
+            break
+        if msg_type == MSG_FRAME_RECORDS:
+            frame = frame_records.decode_frame(payload)
+        elif msg_type == MSG_FRAME_DATA:
+            frame = json.loads(payload.decode('utf-8'))
+            json_frames += 1
+        else:
+            continue
+
+        walls_hash, sprites_hash, walls, sprites = hash_frame(frame)
+
+        if index >= len(golden):
+            index += 1
+            continue
+
+        _, tic, expect_walls, expect_sprites = golden[index]
+        frame_tic = frame.get('tic')
+        if walls_hash != expect_walls or sprites_hash != expect_sprites or frame_tic != tic:
+            mismatches += 1
+            if first_mismatch is None:
+                first_mismatch = index
+                print(f"MISMATCH at frame {index} (tic {frame_tic}, expected tic {tic})")
+                if frame_tic != tic:
+                    print("  tic differs")
+                if walls_hash != expect_walls:
+                    print(f"  walls differ ({len(walls)} records):")
+                    for i, w in enumerate(walls):
+                        print(f"    wall {i}: {' '.join(map(str, w))}")
+                if sprites_hash != expect_sprites:
+                    print(f"  sprites differ ({len(sprites)} records):")
+                    for i, s in enumerate(sprites):
+                        print(f"    sprite {i}: {' '.join(map(str, s))}")
+                print(f"  Compare with: <golden>.frame{index}.txt from a -golden run")
+        index += 1
+
+    conn.close()
+    server.close()
+    try:
+        os.unlink(SOCKET_PATH)
+    except OSError:
+        pass
+
+    print("\n" + "=" * 70)
+    if records and json_frames > 0:
+        # DOOM falls back to JSON when the schema hashes differ
+        print(f"FAIL - {json_frames} frames arrived as JSON, not records "
+              f"(schema {frame_records.SCHEMA_HASH_HEX} not accepted - stale build?)")
+        return False
+    if mismatches == 0 and index == len(golden):
+        print(f"PASS - {index} frames match")
+        return True
+
+    print(f"FAIL - {mismatches} of {index} frames differ "
+          f"(received {index}, golden has {len(golden)})")
+    if first_mismatch is not None:
+        print(f"First difference at frame {first_mismatch}")
+    return False
+
+
+if __name__ == '__main__':
+    args = sys.argv[1:]
+    records = '--records' in args
+    if records:
+        args.remove('--records')
+    if len(args) != 1:
+        print(f"Usage: {sys.argv[0]} [--records] <golden file>")
+        sys.exit(2)
+    sys.exit(0 if run_check(args[0], records) else 1)
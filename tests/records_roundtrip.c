@@ -0,0 +1,172 @@
+/**
+ * records_roundtrip.c
+ *
+ * Binary frame record check: encodes synthetic frames both ways the
+ * extractor can send them - MSG_FRAME_DATA JSON (doom_json.c) and
+ * MSG_FRAME_RECORDS (doom_records.h packers + JSON tail) - and writes the
+ * payload pairs to stdout. records_roundtrip.py decodes the records with
+ * kicad_doom_plugin/frame_records.py and requires the same dict as
+ * json.loads() of the JSON payload, so packer, schema and decoder are
+ * checked against the reference path together.
+ *
+ * Output, per frame: [uint32 json_len][json][uint32 records_len][records]
+ *
+ * Build from the project root (after build.sh has copied the platform files
+ * into ../doomgeneric):
+ *   DG=../doomgeneric/doomgeneric
+ *   cc -O2 -I $DG tests/records_roundtrip.c $DG/doom_json.c -o records_roundtrip
+ *   ./records_roundtrip | python3 tests/records_roundtrip.py
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "doom_frame.h"
+#include "doom_json.h"
+#include "doom_records.h"
+
+#define FRAMES 64  /* Distinct synthetic frames */
+
+static doom_frame_t g_frame;
+static char g_json_buf[262144];
+static uint8_t g_records_buf[RECORD_FRAME_SIZE + MAXDRAWSEGS * RECORD_WALL_SIZE +
+                             MAXVISSPRITES * RECORD_ENTITY_SIZE + 262144];
+
+/**
+ * Helper: Random int over the whole 32-bit range.
+ */
+static int rand_int(void) {
+    return (int)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+}
+
+/**
+ * Helper: Frame with the value ranges the extractor produces. Frame 0 is
+ * empty, frame 1 is full (MAXDRAWSEGS walls, MAXVISSPRITES sprites) with
+ * extreme coordinates; the rest are random.
+ */
+static void make_frame(doom_frame_t* frame, int index) {
+    frame->frame = index * 7;
+    frame->tic = index == 1 ? 0x7fffffff : index * 2;
+
+    frame->wall_count = index == 0 ? 0 : index == 1 ? MAXDRAWSEGS : rand() % 160;
+    for (int i = 0; i < frame->wall_count; i++) {
+        wall_record_t* w = &frame->walls[i];
+        w->x1 = rand_int();
+        w->x2 = rand_int();
+        w->y1_top = rand_int();
+        w->y1_bottom = rand_int();
+        w->y2_top = (i % 3) ? rand() % 200 - 20 : (int)0x80000000;
+        w->y2_bottom = (i % 3) ? rand() % 200 : 0x7fffffff;
+        w->distance = (i % 5) ? rand() % 1000 : 999;
+        w->silhouette = rand() % 4;
+    }
+
+    frame->sprite_count = index == 0 ? 0 : index == 1 ? MAXVISSPRITES : rand() % 24;
+    for (int i = 0; i < frame->sprite_count; i++) {
+        sprite_record_t* e = &frame->sprites[i];
+        e->x = rand_int();
+        e->y_top = rand_int();
+        e->y_bottom = rand_int();
+        e->height = rand_int();
+        e->type = rand() % 140;
+        e->distance = (i % 5) ? rand() % 1000 : 0;
+        e->id = (i % 2) ? rand_int() : 0;
+        e->has_prev = (i % 4) == 1;
+        e->prev[0] = e->has_prev ? rand_int() : 0;
+        e->prev[1] = e->has_prev ? rand_int() : 0;
+        e->prev[2] = e->has_prev ? rand_int() : 0;
+    }
+}
+
+/**
+ * Helper: Frame fields that stay JSON in both transports.
+ */
+static void encode_tail(json_writer_t* w, const doom_frame_t* frame) {
+    JSON_LITERAL(w, "{\"frame\":");
+    doom_json_int(w, frame->frame);
+    JSON_LITERAL(w, ",\"tic\":");
+    doom_json_int(w, frame->tic);
+    JSON_LITERAL(w, ",\"time_us\":");
+    doom_json_u64(w, 81234567890ULL + frame->tic);
+    JSON_LITERAL(w, ",\"view\":{\"x\":");
+    doom_json_int(w, 68157440);
+    JSON_LITERAL(w, ",\"y\":");
+    doom_json_int(w, -236978176);
+    JSON_LITERAL(w, ",\"z\":");
+    doom_json_int(w, 2686976);
+    JSON_LITERAL(w, ",\"angle\":");
+    doom_json_uint(w, 1073741824u);
+    doom_json_char(w, '}');
+}
+
+/**
+ * Reference: MSG_FRAME_DATA payload.
+ */
+static size_t encode_json(const doom_frame_t* frame, char* buf, size_t size) {
+    json_writer_t w;
+    doom_json_init(&w, buf, size);
+
+    encode_tail(&w, frame);
+    JSON_LITERAL(&w, ",\"walls\":[");
+    for (int i = 0; i < frame->wall_count; i++) {
+        doom_json_wall(&w, &frame->walls[i], i == 0);
+    }
+    JSON_LITERAL(&w, "],\"entities\":[");
+    for (int i = 0; i < frame->sprite_count; i++) {
+        doom_json_entity(&w, &frame->sprites[i], i == 0);
+    }
+    JSON_LITERAL(&w, "]}");
+
+    return w.overflow ? 0 : w.len;
+}
+
+/**
+ * MSG_FRAME_RECORDS payload, laid out like extract_vectors_to_json().
+ */
+static size_t encode_records(const doom_frame_t* frame, uint8_t* buf, size_t size) {
+    uint8_t* out = doom_records_pack_frame(buf, frame);
+    for (int i = 0; i < frame->wall_count; i++) {
+        out = doom_records_pack_wall(out, &frame->walls[i]);
+    }
+    for (int i = 0; i < frame->sprite_count; i++) {
+        out = doom_records_pack_entity(out, &frame->sprites[i]);
+    }
+
+    json_writer_t w;
+    doom_json_init(&w, (char*)out, size - (out - buf));
+    encode_tail(&w, frame);
+    doom_json_char(&w, '}');
+
+    return w.overflow ? 0 : (size_t)(out - buf) + w.len;
+}
+
+/**
+ * Helper: Write one length-prefixed payload.
+ */
+static int write_payload(const void* data, size_t len) {
+    uint32_t len32 = (uint32_t)len;
+    return fwrite(&len32, sizeof(len32), 1, stdout) == 1 &&
+           fwrite(data, 1, len, stdout) == len;
+}
+
+int main(void) {
+    srand(1234);
+    for (int i = 0; i < FRAMES; i++) {
+        make_frame(&g_frame, i);
+
+        size_t json_len = encode_json(&g_frame, g_json_buf, sizeof(g_json_buf));
+        size_t records_len = encode_records(&g_frame, g_records_buf, sizeof(g_records_buf));
+        if (json_len == 0 || records_len == 0) {
+            fprintf(stderr, "FAIL: frame %d doesn't fit the buffers\n", i);
+            return 1;
+        }
+        if (!write_payload(g_json_buf, json_len) || !write_payload(g_records_buf, records_len)) {
+            fprintf(stderr, "FAIL: cannot write frame %d\n", i);
+            return 1;
+        }
+    }
+
+    return fflush(stdout) == 0 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+Binary Frame Record Round-Trip Check
+
+Reads the payload pairs written by records_roundtrip.c (the same frames as
+MSG_FRAME_DATA JSON and as MSG_FRAME_RECORDS), decodes the records with the
+plugin's generated decoder and requires exactly what json.loads() gives for
+the JSON payload. Run this whenever frame_records.schema, gen_records.py or
+the packers change.
+
+Usage:
+    ./records_roundtrip | python3 tests/records_roundtrip.py
+"""
+
+import json
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', 'kicad_doom_plugin'))
+import frame_records  # noqa: E402
+
+
+def read_payload(stream):
+    """Read one [uint32 length][payload] (None at end of input)."""
+    header = stream.read(4)
+    if len(header) < 4:
+        return None
+    (length,) = struct.unpack('<I', header)
+    payload = stream.read(length)
+    if len(payload) < length:
+        raise ValueError("truncated payload")
+    return payload
+
+
+def run_check(stream):
+    frames = 0
+    walls = 0
+    entities = 0
+
+    while True:
+        json_payload = read_payload(stream)
+        if json_payload is None:
+            break
+        records_payload = read_payload(stream)
+        if records_payload is None:
+            print(f"FAIL - frame {frames} has no records payload")
+            return False
+
+        expected = json.loads(json_payload.decode('utf-8'))
+        decoded = frame_records.decode_frame(records_payload)
+        if decoded != expected:
+            print(f"FAIL - frame {frames} decodes differently")
+            for key in sorted(set(expected) | set(decoded)):
+                want, got = expected.get(key), decoded.get(key)
+                if want == got:
+                    continue
+                if isinstance(want, list) and isinstance(got, list) and len(want) == len(got):
+                    # Only the first differing record, lists can be long
+                    i = next(i for i, (a, b) in enumerate(zip(want, got)) if a != b)
+                    key, want, got = f"{key}[{i}]", want[i], got[i]
+                print(f"  {key}:")
+                print(f"    json:    {want}")
+                print(f"    records: {got}")
+            return False
+
+        frames += 1
+        walls += len(expected['walls'])
+        entities += len(expected['entities'])
+
+    if frames == 0:
+        print("FAIL - no frames on stdin")
+        return False
+
+    print(f"PASS - {frames} frames ({walls} walls, {entities} entities) identical, "
+          f"schema {frame_records.SCHEMA_HASH_HEX}")
+    return True
+
+
+if __name__ == '__main__':
+    sys.exit(0 if run_check(sys.stdin.buffer) else 1)